@@ -0,0 +1,507 @@
+﻿/** ****************************************************************************************************
+ * @file
+ * @brief 処理速度の計測関連
+ **************************************************************************************************** */
+#include "Benchmark.h"
+
+#if defined(MY_BENCHMARK)
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include "../GameObject/Data/StageData.h"
+#include "../GameObject/Data/GroundData.h"
+#include "../GameObject/Object/Stage.h"
+#include "../GameObject/Object/StagePiece.h"
+#include "../GameObject/Object/Player.h"
+
+namespace
+{
+	std::atomic<size_t> gAllocationNum{ 0 };	//!< これまでに確保した回数
+
+	/** ****************************************************************************************************
+	 * @brief			回数を数えて確保する
+	 * @param[in] size	確保する大きさ
+	 * @return			確保した領域
+	 **************************************************************************************************** */
+	void* CountedAllocate(std::size_t size)
+	{
+		gAllocationNum.fetch_add(1, std::memory_order_relaxed);
+
+		if (auto pMemory = std::malloc(size ? size : 1))
+		{
+			return pMemory;
+		}
+
+		throw std::bad_alloc{};
+	}
+
+	/** ****************************************************************************************************
+	 * @brief				回数を数えて境界をそろえて確保する
+	 * @param[in] size		確保する大きさ
+	 * @param[in] alignment	そろえる境界
+	 * @return				確保した領域
+	 **************************************************************************************************** */
+	void* CountedAllocate(std::size_t size, std::align_val_t alignment)
+	{
+		gAllocationNum.fetch_add(1, std::memory_order_relaxed);
+
+#if defined(_MSC_VER)
+		auto pMemory = _aligned_malloc(size ? size : 1, static_cast<std::size_t>(alignment));
+#else
+		const auto align = static_cast<std::size_t>(alignment);
+		auto pMemory = std::aligned_alloc(align, ((size ? size : 1) + align - 1) / align * align);
+#endif
+
+		if (pMemory)
+		{
+			return pMemory;
+		}
+
+		throw std::bad_alloc{};
+	}
+
+	/** ****************************************************************************************************
+	 * @brief				境界をそろえて確保した領域を解放する
+	 * @param[in] pMemory	解放する領域
+	 **************************************************************************************************** */
+	void AlignedFree(void* pMemory) noexcept
+	{
+#if defined(_MSC_VER)
+		_aligned_free(pMemory);
+#else
+		std::free(pMemory);
+#endif
+	}
+}
+
+/** ****************************************************************************************************
+ * @brief 確保した回数を数えるために置き換える(配列・境界指定の版も既定の実装を通らないように全て置き換える)
+ **************************************************************************************************** */
+void* operator new(std::size_t size)
+{
+	return CountedAllocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+	return CountedAllocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+	return CountedAllocate(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+	return CountedAllocate(size, alignment);
+}
+
+void operator delete(void* pMemory) noexcept
+{
+	std::free(pMemory);
+}
+
+void operator delete(void* pMemory, std::size_t) noexcept
+{
+	std::free(pMemory);
+}
+
+void operator delete[](void* pMemory) noexcept
+{
+	std::free(pMemory);
+}
+
+void operator delete[](void* pMemory, std::size_t) noexcept
+{
+	std::free(pMemory);
+}
+
+void operator delete(void* pMemory, std::align_val_t) noexcept
+{
+	AlignedFree(pMemory);
+}
+
+void operator delete(void* pMemory, std::size_t, std::align_val_t) noexcept
+{
+	AlignedFree(pMemory);
+}
+
+void operator delete[](void* pMemory, std::align_val_t) noexcept
+{
+	AlignedFree(pMemory);
+}
+
+void operator delete[](void* pMemory, std::size_t, std::align_val_t) noexcept
+{
+	AlignedFree(pMemory);
+}
+
+namespace MySystem::Benchmark
+{
+	namespace
+	{
+		using Clock = std::chrono::steady_clock;
+
+		static constexpr uint64 gRANDOM_SEED = 20221031;	//!< 生成するステージの乱数の種(毎回同じステージにする)
+		static constexpr size_t gMIN_ITERATION = 3;			//!< 最低限計測する回数
+		static constexpr std::chrono::milliseconds gMIN_MEASURE_TIME{ 200 };	//!< 最低限計測する時間
+		static constexpr size_t gHIT_CHECK_STEP_NUM = 60;	//!< 当たり判定の計測でプレイヤーを作り直すまでの更新数
+
+		//! 生成するタイルの UV(ステージで一番使われている地面のマス。見た目だけで計測結果は変わらない)
+		static constexpr Point gTILE_UV{ 8, 0 };
+
+		//! 計測するカケラの数
+		static constexpr std::array<size_t, 3> gPIECE_NUMS{ 1, 5, StagePieceData::gMAX_PIECE_NUM };
+
+		//! 計測するカケラ1枚当たりのタイルの数
+		static constexpr std::array<size_t, 3> gTILE_NUMS{ 60, 240, StagePieceData::gMAX_WIDTH * StagePieceData::gMAX_HEIGHT };
+
+		/** ****************************************************************************************************
+		 * @brief 計測結果
+		 **************************************************************************************************** */
+		struct Result
+		{
+			String	name;				//!< 計測した処理
+			size_t	pieceNum;			//!< カケラの数
+			size_t	tileNum;			//!< カケラ1枚当たりのタイルの数
+			size_t	iteration;			//!< 計測した回数
+			double	nsPerOp;			//!< 1回当たりの時間(ナノ秒)
+			double	allocationsPerOp;	//!< 1回当たりの確保回数
+		};
+
+		/** ****************************************************************************************************
+		 * @brief					処理を繰り返して計測する
+		 * @tparam Setup			計測前の準備(計測しない)
+		 * @tparam Body				計測する処理
+		 * @param[in] name			計測する処理の名前
+		 * @param[in] pieceNum		カケラの数
+		 * @param[in] tileNum		カケラ1枚当たりのタイルの数
+		 * @param[in] opNum			Body 1回に含まれる処理の回数
+		 * @param[in] setup			計測前の準備
+		 * @param[in] body			計測する処理
+		 * @return					計測結果
+		 **************************************************************************************************** */
+		template<typename Setup, typename Body>
+		Result Measure(StringView name, const size_t pieceNum, const size_t tileNum, const size_t opNum, Setup setup, Body body)
+		{
+			Clock::duration totalTime{ 0 };
+			size_t totalAllocationNum = 0;
+			size_t iteration = 0;
+
+			while (iteration < gMIN_ITERATION || totalTime < gMIN_MEASURE_TIME)
+			{
+				setup();
+
+				const auto allocationNum = gAllocationNum.load(std::memory_order_relaxed);
+				const auto start = Clock::now();
+
+				body();
+
+				totalTime += Clock::now() - start;
+				totalAllocationNum += gAllocationNum.load(std::memory_order_relaxed) - allocationNum;
+				++iteration;
+			}
+
+			const auto totalOpNum = static_cast<double>(iteration * opNum);
+
+			return Result{
+				String{ name },
+				pieceNum,
+				tileNum,
+				iteration,
+				static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(totalTime).count()) / totalOpNum,
+				static_cast<double>(totalAllocationNum) / totalOpNum
+			};
+		}
+
+		/** ****************************************************************************************************
+		 * @brief					計測用のステージを生成
+		 * @param[in] pieceNum		カケラの数
+		 * @param[in] tileNum		カケラ1枚当たりのタイルの数
+		 * @param[in] hasGimmick	ギミックを置くかどうか
+		 * @return					ステージのデータ
+		 **************************************************************************************************** */
+		StageData::Desc CreateStageDesc(const size_t pieceNum, const size_t tileNum, const bool hasGimmick)
+		{
+			DefaultRNG rng{ gRANDOM_SEED };
+			const auto tileSize = Vec2{ TileData::gTILE_SIZE, TileData::gTILE_SIZE };
+
+			Array<Point> aCells;
+			for (int32 y = 0; y < StagePieceData::gMAX_HEIGHT; ++y)
+			{
+				for (int32 x = 0; x < StagePieceData::gMAX_WIDTH; ++x)
+				{
+					aCells.emplace_back(x, y);
+				}
+			}
+
+			StageData::Desc desc;
+			desc.stageName = U"Benchmark";
+
+			for (size_t i = 0; i < pieceNum; ++i)
+			{
+				auto& rPieceDesc = desc.aPieceDescs.emplace_back();
+
+				rPieceDesc.backType = static_cast<StagePieceData::TypeIndex>(i % static_cast<size_t>(StagePieceData::Type::Max));
+				rPieceDesc.backScale = Vec2{ tileSize.x * StagePieceData::gMAX_WIDTH, tileSize.y * StagePieceData::gMAX_HEIGHT };
+
+				// 少しずつずらして重ねる
+				rPieceDesc.position = Vec2{ tileSize.x * static_cast<double>(i % 5) * 2.0, tileSize.y * static_cast<double>(i / 5) * 2.0 };
+
+				auto leftTop = -rPieceDesc.backScale / 2.0;
+
+				aCells.shuffle(rng);
+
+				for (const auto& cell : aCells.take(tileNum))
+				{
+					auto& tile = rPieceDesc.aTileDescs.emplace_back();
+					tile.SetUV(gTILE_UV);
+					tile.SetPosition(Vec2{ leftTop.x + tileSize.x * cell.x, leftTop.y + tileSize.y * cell.y });
+
+					// 一部を回転させた三角形にする
+					if (rng() % 8 == 0)
+					{
+						tile.tileType = static_cast<TileData::TypeIndex>(TileData::Type::Triangle);
+						tile.turn = static_cast<TileData::Turn>(rng() % static_cast<uint32>(TileData::Turn::Max));
+					}
+				}
+
+				if (hasGimmick && i == 0)
+				{
+					auto& player = rPieceDesc.aGimmiclDesc.emplace_back();
+					player.gimmickType = static_cast<GimmickData::TypeIndex>(GimmickData::Type::Player);
+					player.SetPosition(leftTop + tileSize);
+
+					auto& goal = rPieceDesc.aGimmiclDesc.emplace_back();
+					goal.gimmickType = static_cast<GimmickData::TypeIndex>(GimmickData::Type::Goal);
+					goal.SetPosition(Vec2{ leftTop.x + tileSize.x * (StagePieceData::gMAX_WIDTH - 2), leftTop.y + tileSize.y });
+				}
+			}
+
+			return desc;
+		}
+
+		/** ****************************************************************************************************
+		 * @brief				ステージを StageData::Load で読める形式で書き出す
+		 * @param[in] desc		書き出すデータ
+		 * @param[in] path		書き出すファイルのパス
+		 * @retval true			書き出せた
+		 * @retval false		書き出せなかった
+		 **************************************************************************************************** */
+		bool WriteStage(const StageData::Desc& desc, FilePathView path)
+		{
+			TextWriter writer{ path };
+
+			if (not writer)
+			{
+				return false;
+			}
+
+			writer.writeln(desc.stageName);
+			writer.writeln(desc.aPieceDescs.size());
+
+			for (const auto& piece : desc.aPieceDescs)
+			{
+				writer.writeln(U"{},{},{},{},\"({}, {})\""_fmt(piece.position.x, piece.position.y, piece.scale, piece.angle, piece.backScale.x, piece.backScale.y));
+				writer.writeln(U"{},{},{},{}"_fmt(piece.canMoving, piece.canScaling, piece.canRolling, static_cast<int32>(piece.backType)));
+
+				writer.writeln(piece.aTileDescs.size());
+				for (const auto& tile : piece.aTileDescs)
+				{
+					const auto position = tile.GetPosition();
+					const auto uv = tile.GetUV();
+					writer.writeln(U"{},{},{},{},{},{}"_fmt(position.x, position.y, tile.GetAngle(), static_cast<int32>(tile.tileType), uv.x, uv.y));
+				}
+
+				writer.writeln(piece.aGimmiclDesc.size());
+				for (const auto& gimmick : piece.aGimmiclDesc)
+				{
+					const auto position = gimmick.GetPosition();
+					writer.writeln(U"{},{},{},{}"_fmt(position.x, position.y, gimmick.GetAngle(), static_cast<int32>(gimmick.gimmickType)));
+				}
+			}
+
+			return true;
+		}
+
+		/** ****************************************************************************************************
+		 * @brief				カケラのタイルを合成した簡略化前の当たり判定を取得
+		 * @param[in] desc		ステージのデータ
+		 * @return				全てのカケラの当たり判定(ステージ座標)
+		 **************************************************************************************************** */
+		Array<Polygon> CreateMergedHitBoxes(const StageData::Desc& desc)
+		{
+			Array<Polygon> aResults;
+
+			for (const auto& pieceDesc : desc.aPieceDescs)
+			{
+				Array<size_t> aOffGridIndices;
+				auto aHitBoxes = TileData::CreateGridHitBoxes(pieceDesc.aTileDescs, aOffGridIndices);
+
+				for (const auto& hitBox : aHitBoxes)
+				{
+					aResults << hitBox.movedBy(pieceDesc.position);
+				}
+			}
+
+			return aResults;
+		}
+
+		/** ****************************************************************************************************
+		 * @brief					カケラの数とタイルの数の組み合わせ1つ分を計測
+		 * @param[in] pieceNum		カケラの数
+		 * @param[in] tileNum		カケラ1枚当たりのタイルの数
+		 * @param[out] aResults		計測結果の追加先
+		 **************************************************************************************************** */
+		void MeasureStage(const size_t pieceNum, const size_t tileNum, Array<Result>& aResults)
+		{
+			const auto desc = CreateStageDesc(pieceNum, tileNum, true);
+			const auto path = FileSystem::TemporaryDirectoryPath() + U"benchmark_stage.csv";
+
+			if (not WriteStage(desc, path))
+			{
+				return;
+			}
+
+			Stage stage{ Vec2{ 0.0, 0.0 }, Vec2{ 1.0, 1.0 }, 0.0, nullptr };
+
+			// ステージの読み込み
+			aResults << Measure(U"StageData::Load", pieceNum, tileNum, 1,
+				[] {},
+				[&] { StageData::Load(path); }
+			);
+
+			// カケラの生成(ギミックはステージに溜まっていくので置かない)
+			{
+				const auto pieceDesc = CreateStageDesc(pieceNum, tileNum, false);
+				Array<std::unique_ptr<StagePiece>> apPieces;
+
+				aResults << Measure(U"StagePiece::StagePiece", pieceNum, tileNum, pieceNum,
+					[&] { apPieces.clear(); },
+					[&] {
+						for (size_t i = 0; i < pieceNum; ++i)
+						{
+							apPieces.emplace_back(std::make_unique<StagePiece>(pieceDesc.aPieceDescs[i], static_cast<uint8>(i), &stage, nullptr));
+						}
+					}
+				);
+
+				// 事前に合成した当たり判定を使うカケラの生成
+				auto bakedDesc = pieceDesc;
+				for (auto& rPieceDesc : bakedDesc.aPieceDescs)
+				{
+					rPieceDesc.aBakedHitBoxes = TileData::CreateHitBoxes(rPieceDesc.aTileDescs);
+					rPieceDesc.bakedHash = TileData::CalcuHitBoxHash(rPieceDesc.aTileDescs);
+				}
+
+				aResults << Measure(U"StagePiece::StagePiece(baked)", pieceNum, tileNum, pieceNum,
+					[&] { apPieces.clear(); },
+					[&] {
+						for (size_t i = 0; i < pieceNum; ++i)
+						{
+							apPieces.emplace_back(std::make_unique<StagePiece>(bakedDesc.aPieceDescs[i], static_cast<uint8>(i), &stage, nullptr));
+						}
+					}
+				);
+
+				// 当たり判定の簡略化
+				const auto aSources = CreateMergedHitBoxes(pieceDesc);
+				Array<Polygon> aTargets;
+
+				aResults << Measure(U"TileData::GetSimplePolygon", pieceNum, tileNum, 1,
+					[&] { aTargets = aSources; },
+					[&] { TileData::GetSimplePolygon(aTargets, 2.0, 0.00001); }
+				);
+			}
+
+			// ステージ全体の当たり判定の合成
+			StageData::Load(path);
+			stage.CreateStage();
+			FileSystem::Remove(path);
+
+			aResults << Measure(U"Stage::CreateHitBox", pieceNum, tileNum, 1,
+				[] {},
+				[&] { stage.RebuildHitBox(); }
+			);
+
+			// プレイヤーの当たり判定
+			{
+				GroundData::Grid grid;
+				grid.Create(CreateMergedHitBoxes(desc));
+
+				const Array<std::weak_ptr<GimmickData::Gimmick>> apGimmicks;
+				const double stepTime = 1.0 / 60.0;
+
+				InputData::State input;
+				input.isRightPressed = true;
+				input.isJumpPressed = true;
+
+				GimmickData::Desc playerDesc;
+				playerDesc.gimmickType = static_cast<GimmickData::TypeIndex>(GimmickData::Type::Player);
+
+				std::unique_ptr<Player> pPlayer;
+				size_t stepNum = 0;
+
+				// 移動は準備側で進めて、当たり判定だけを計測する
+				aResults << Measure(U"Player::HitCheck", pieceNum, tileNum, 1,
+					[&] {
+						// ステージの外まで落ちていかないように、一定の更新数ごとに初めの位置から作り直す
+						if (stepNum % gHIT_CHECK_STEP_NUM == 0)
+						{
+							pPlayer = std::make_unique<Player>(playerDesc, nullptr);
+							pPlayer->UpdateDirection();
+						}
+						++stepNum;
+
+						pPlayer->Update(stepTime, input);
+					},
+					[&] { pPlayer->HitCheck(grid, apGimmicks); }
+				);
+			}
+		}
+	}
+
+	bool Run(FilePathView outputPath)
+	{
+		Array<Result> aResults;
+
+		for (auto pieceNum : gPIECE_NUMS)
+		{
+			for (auto tileNum : gTILE_NUMS)
+			{
+				MeasureStage(pieceNum, tileNum, aResults);
+			}
+		}
+
+		TextWriter writer{ outputPath };
+
+		if (not writer)
+		{
+			return false;
+		}
+
+		writer.writeln(U"name,piece_num,tile_num,iteration,ns_per_op,allocations_per_op");
+
+		for (const auto& result : aResults)
+		{
+			writer.writeln(U"{},{},{},{},{:.1f},{:.2f}"_fmt(result.name, result.pieceNum, result.tileNum, result.iteration, result.nsPerOp, result.allocationsPerOp));
+		}
+
+		return true;
+	}
+}
+
+#else
+
+namespace MySystem::Benchmark
+{
+	bool Run(FilePathView)
+	{
+		return false;
+	}
+}
+
+#endif
@@ -0,0 +1,21 @@
+﻿/** ****************************************************************************************************
+ * @file
+ * @brief 処理速度の計測関連
+ **************************************************************************************************** */
+#pragma once
+
+#include <Siv3D.hpp>
+
+/** ****************************************************************************************************
+ * @brief 処理速度の計測関連(MY_BENCHMARK を定義したビルドでのみ使える)
+ **************************************************************************************************** */
+namespace MySystem::Benchmark
+{
+	/** ****************************************************************************************************
+	 * @brief					全ての計測を実行して結果を CSV に書き出す
+	 * @param[in] outputPath	結果を書き出すファイルのパス
+	 * @retval true				書き出せた
+	 * @retval false			書き出せなかった
+	 **************************************************************************************************** */
+	bool Run(FilePathView outputPath);
+}
@@ -6,11 +6,32 @@
 
 namespace MySystem::GimmickData
 {
-	Gimmick::Gimmick()
+	namespace
+	{
+		std::array<Texture, static_cast<TypeIndex>(Type::Max) + 1> gaTextures;	//!< 種類ごとの解決済みのテクスチャ
+	}
+
+	void RegisterTextures()
 	{
 		TextureAsset::Register(gLABEL_TEXTURE[static_cast<TypeIndex>(Type::Player)], U"Assets/Image/siv3d-kun-16.png");
 		TextureAsset::Register(gLABEL_TEXTURE[static_cast<TypeIndex>(Type::Goal)], U"🚩"_emoji);
 		TextureAsset::Register(gLABEL_TEXTURE[static_cast<TypeIndex>(Type::Max)], U"✖"_emoji);
+
+		// 描画のたびにラベルで引かないように、ここで一度だけ解決しておく
+		for (size_t i = 0; i < gaTextures.size(); ++i)
+		{
+			gaTextures[i] = TextureAsset(gLABEL_TEXTURE[i]);
+		}
+	}
+
+	const Texture& GetTexture(const TypeIndex type) noexcept
+	{
+		return gaTextures[Min<size_t>(type, static_cast<TypeIndex>(Type::Max))];
+	}
+
+	Gimmick::Gimmick()
+	{
+
 	}
 
 	Gimmick::~Gimmick()
@@ -18,7 +39,7 @@ namespace MySystem::GimmickData
 
 	}
 
-	void Gimmick::Update()
+	void Gimmick::Update(const double deltaTime, const InputData::State& input)
 	{
 
 	}
@@ -27,4 +48,12 @@ namespace MySystem::GimmickData
 	{
 
 	}
+
+	bool Gimmick::IsVisible(const RectF& viewRect) const
+	{
+		// 当たり判定は見た目より小さいことがあるので、半径を倍にして見た目を包む
+		const auto collision = GetCollision();
+
+		return collision.stretched(collision.r).intersects(viewRect);
+	}
 }
@@ -6,6 +6,8 @@
 
 #include <Siv3D.hpp>
 #include "Transform.h"
+#include "InputData.h"
+#include "TileData.h"
 
 /** ****************************************************************************************************
  * @brief ギミックのデータ操作関連
@@ -43,12 +45,13 @@ namespace MySystem::GimmickData
 	};
 
 	/** ****************************************************************************************************
-	 * @brief ギミックのデータ格納用
+	 * @brief ギミックのデータ格納用(タイルと同じ配置の単位で詰めて持ち、生成する時に実数に戻す)
 	 **************************************************************************************************** */
 	struct Desc
 	{
-		Vec2 position;	//!< 表示座標
-		double angle;	//!< 表示角度
+		TileData::GridIndex	x;		//!< 表示座標(配置の単位)
+		TileData::GridIndex	y;		//!< 表示座標(配置の単位)
+		TileData::Turn		turn;	//!< 表示角度
 
 		TypeIndex gimmickType;	//!< ギミックの種類
 
@@ -56,14 +59,74 @@ namespace MySystem::GimmickData
 		 * @brief コンストラクタ
 		 **************************************************************************************************** */
 		inline Desc() noexcept :
-			position{ Vec2{ 0.0, 0.0 } },
-			angle{ 0.0 },
+			x{ 0 },
+			y{ 0 },
+			turn{ TileData::Turn::Deg0 },
 			gimmickType{ static_cast<TypeIndex>(0) }
 		{
 
 		}
+
+		/** ****************************************************************************************************
+		 * @brief	表示座標を取得
+		 * @return	表示座標
+		 **************************************************************************************************** */
+		inline Vec2 GetPosition() const noexcept
+		{
+			return Vec2{ x * TileData::gGRID_SIZE, y * TileData::gGRID_SIZE };
+		}
+
+		/** ****************************************************************************************************
+		 * @brief	表示角度を取得
+		 * @return	表示角度(ラジアン)
+		 **************************************************************************************************** */
+		inline double GetAngle() const noexcept
+		{
+			return static_cast<double>(turn) * Math::HalfPi;
+		}
+
+		/** ****************************************************************************************************
+		 * @brief				表示座標を設定(配置の単位に丸める)
+		 * @param[in] position	表示座標
+		 * @retval true			丸める前から単位に乗っていた
+		 * @retval false		単位に乗っていないか範囲外
+		 **************************************************************************************************** */
+		inline bool SetPosition(const Vec2& position) noexcept
+		{
+			const bool isOnGridX = TileData::QuantizePosition(position.x, x);
+			const bool isOnGridY = TileData::QuantizePosition(position.y, y);
+
+			return isOnGridX && isOnGridY;
+		}
+
+		/** ****************************************************************************************************
+		 * @brief				表示角度を設定(90度単位に丸める)
+		 * @param[in] angle		表示角度(ラジアン)
+		 * @retval true			丸める前から90度単位だった
+		 * @retval false		90度単位ではなかった
+		 **************************************************************************************************** */
+		inline bool SetAngle(const double angle) noexcept
+		{
+			return TileData::QuantizeAngle(angle, turn);
+		}
+
+		bool operator==(const Desc&) const = default;
 	};
 
+	static_assert(sizeof(Desc) == 6);
+
+	/** ****************************************************************************************************
+	 * @brief ギミックのテクスチャを登録(描画する側で一度だけ呼ぶ)
+	 **************************************************************************************************** */
+	void RegisterTextures();
+
+	/** ****************************************************************************************************
+	 * @brief				ギミックのテクスチャを取得(登録時に解決しておいたものを返す)
+	 * @param[in] type		ギミックの種類
+	 * @return				テクスチャ
+	 **************************************************************************************************** */
+	const Texture& GetTexture(const TypeIndex type) noexcept;
+
 	class Gimmick
 	{
 	public:
@@ -78,9 +141,11 @@ namespace MySystem::GimmickData
 		virtual ~Gimmick();
 
 		/** ****************************************************************************************************
-		 * @brief 更新
+		 * @brief					更新
+		 * @param[in] deltaTime		1回の更新で進める時間
+		 * @param[in] input			入力の状態
 		 **************************************************************************************************** */
-		virtual void Update();
+		virtual void Update(const double deltaTime, const InputData::State& input);
 
 		/** ****************************************************************************************************
 		 * @brief 描画
@@ -93,6 +158,14 @@ namespace MySystem::GimmickData
 		 **************************************************************************************************** */
 		virtual Circle GetCollision() const = 0;
 
+		/** ****************************************************************************************************
+		 * @brief				画面に映るか確認
+		 * @param[in] viewRect	画面に映る範囲(ワールド座標)
+		 * @retval true			映る
+		 * @retval false		映らない
+		 **************************************************************************************************** */
+		bool IsVisible(const RectF& viewRect) const;
+
 		/** ****************************************************************************************************
 		 * @brief				有効化するかどうか設定
 		 * @param[in] isActive	有効化するかどうか
@@ -0,0 +1,207 @@
+﻿/** ****************************************************************************************************
+ * @file
+ * @brief 地面の当たり判定操作関連
+ **************************************************************************************************** */
+#include "GroundData.h"
+
+namespace MySystem::GroundData
+{
+	Grid::Grid() noexcept :
+		_origin{ 0.0, 0.0 },
+		_cellSize{ gDEFAULT_CELL_SIZE },
+		_cellNum{ 0, 0 },
+		_stamp{ 0 }
+	{
+
+	}
+
+	void Grid::Create(const Array<Polygon>& aPolygons, double cellSize)
+	{
+		Clear();
+
+		// 外周も穴も区別せず線分にする
+		auto addLineString = [this](const LineString& lineString)
+		{
+			for (size_t i = 0, max = lineString.num_lines(CloseRing::Yes); i < max; ++i)
+			{
+				auto& segment = _aSegments.emplace_back();
+				segment.line = lineString.line(i, CloseRing::Yes);
+				segment.normal = lineString.normalAtLine(i, CloseRing::Yes);
+			}
+		};
+
+		for (const auto& polygon : aPolygons)
+		{
+			addLineString(LineString{ polygon.outer() });
+
+			for (const auto& inner : polygon.inners())
+			{
+				addLineString(LineString{ inner });
+			}
+		}
+
+		if (_aSegments.empty())
+		{
+			return;
+		}
+
+		// 全体の範囲
+		Vec2 minPos = _aSegments[0].line.begin;
+		Vec2 maxPos = minPos;
+
+		for (const auto& segment : _aSegments)
+		{
+			minPos.x = Min(minPos.x, Min(segment.line.begin.x, segment.line.end.x));
+			minPos.y = Min(minPos.y, Min(segment.line.begin.y, segment.line.end.y));
+			maxPos.x = Max(maxPos.x, Max(segment.line.begin.x, segment.line.end.x));
+			maxPos.y = Max(maxPos.y, Max(segment.line.begin.y, segment.line.end.y));
+		}
+
+		auto areaSize = maxPos - minPos;
+
+		// マスが多くなりすぎる場合は1マスを大きくする
+		_cellSize = Max(cellSize, 1.0);
+		while (true)
+		{
+			_cellNum.x = static_cast<int32>(areaSize.x / _cellSize) + 1;
+			_cellNum.y = static_cast<int32>(areaSize.y / _cellSize) + 1;
+
+			if (static_cast<size_t>(_cellNum.x) * static_cast<size_t>(_cellNum.y) <= gMAX_CELL_NUM)
+			{
+				break;
+			}
+
+			_cellSize *= 2.0;
+		}
+
+		_origin = minPos;
+
+		const size_t cellCount = static_cast<size_t>(_cellNum.x) * static_cast<size_t>(_cellNum.y);
+
+		// 各マスの線分の数を数えてから詰める
+		Array<uint32> aCounts(cellCount + 1, 0);
+
+		auto forEachCell = [this](const Segment& segment, auto function)
+		{
+			Point cellMin, cellMax;
+			const RectF bounds{
+				Min(segment.line.begin.x, segment.line.end.x),
+				Min(segment.line.begin.y, segment.line.end.y),
+				Abs(segment.line.end.x - segment.line.begin.x),
+				Abs(segment.line.end.y - segment.line.begin.y)
+			};
+
+			if (not GetCellRange(bounds, cellMin, cellMax))
+			{
+				return;
+			}
+
+			for (int32 y = cellMin.y; y <= cellMax.y; ++y)
+			{
+				for (int32 x = cellMin.x; x <= cellMax.x; ++x)
+				{
+					function(static_cast<size_t>(y) * _cellNum.x + x);
+				}
+			}
+		};
+
+		for (const auto& segment : _aSegments)
+		{
+			forEachCell(segment, [&aCounts](size_t cell) { ++aCounts[cell + 1]; });
+		}
+
+		for (size_t i = 1; i <= cellCount; ++i)
+		{
+			aCounts[i] += aCounts[i - 1];
+		}
+
+		_aCellStarts = aCounts;
+		_aCellIndices.resize(aCounts[cellCount]);
+
+		for (uint32 i = 0, max = static_cast<uint32>(_aSegments.size()); i < max; ++i)
+		{
+			forEachCell(_aSegments[i], [this, &aCounts, i](size_t cell) { _aCellIndices[aCounts[cell]++] = i; });
+		}
+
+		_aStamps.resize(_aSegments.size(), 0);
+		_stamp = 0;
+	}
+
+	void Grid::Clear() noexcept
+	{
+		_aSegments.clear();
+		_aCellStarts.clear();
+		_aCellIndices.clear();
+		_aStamps.clear();
+		_cellNum = Size{ 0, 0 };
+		_stamp = 0;
+	}
+
+	void Grid::Query(const RectF& area, Array<uint32>& rIndices) const
+	{
+		rIndices.clear();
+
+		Point cellMin, cellMax;
+		if (not GetCellRange(area, cellMin, cellMax))
+		{
+			return;
+		}
+
+		// 印が一周したら全て消しておく
+		if (++_stamp == 0)
+		{
+			std::fill(_aStamps.begin(), _aStamps.end(), 0);
+			_stamp = 1;
+		}
+
+		for (int32 y = cellMin.y; y <= cellMax.y; ++y)
+		{
+			for (int32 x = cellMin.x; x <= cellMax.x; ++x)
+			{
+				const size_t cell = static_cast<size_t>(y) * _cellNum.x + x;
+
+				for (uint32 i = _aCellStarts[cell], max = _aCellStarts[cell + 1]; i < max; ++i)
+				{
+					const auto index = _aCellIndices[i];
+
+					if (_aStamps[index] == _stamp)
+					{
+						continue;
+					}
+
+					_aStamps[index] = _stamp;
+					rIndices << index;
+				}
+			}
+		}
+	}
+
+	const Array<Segment>& Grid::GetSegments() const noexcept
+	{
+		return _aSegments;
+	}
+
+	bool Grid::GetCellRange(const RectF& area, Point& rMin, Point& rMax) const noexcept
+	{
+		if (_cellNum.x <= 0 || _cellNum.y <= 0)
+		{
+			return false;
+		}
+
+		const auto minPos = (area.tl() - _origin) / _cellSize;
+		const auto maxPos = (area.br() - _origin) / _cellSize;
+
+		// 全く掛かっていない
+		if (maxPos.x < 0.0 || maxPos.y < 0.0 || minPos.x >= _cellNum.x || minPos.y >= _cellNum.y)
+		{
+			return false;
+		}
+
+		rMin.x = Clamp(static_cast<int32>(Floor(minPos.x)), 0, _cellNum.x - 1);
+		rMin.y = Clamp(static_cast<int32>(Floor(minPos.y)), 0, _cellNum.y - 1);
+		rMax.x = Clamp(static_cast<int32>(Floor(maxPos.x)), 0, _cellNum.x - 1);
+		rMax.y = Clamp(static_cast<int32>(Floor(maxPos.y)), 0, _cellNum.y - 1);
+
+		return true;
+	}
+}
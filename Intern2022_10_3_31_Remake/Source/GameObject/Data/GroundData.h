@@ -0,0 +1,96 @@
+﻿/** ****************************************************************************************************
+ * @file
+ * @brief 地面の当たり判定操作関連
+ **************************************************************************************************** */
+#pragma once
+
+#include <Siv3D.hpp>
+#include "TileData.h"
+
+/** ****************************************************************************************************
+ * @brief 地面の当たり判定操作関連
+ **************************************************************************************************** */
+namespace MySystem::GroundData
+{
+	static constexpr double	gDEFAULT_CELL_SIZE = TileData::gTILE_SIZE * 2.0;	//!< 空間分割の1マスの大きさ
+	static constexpr size_t	gMAX_CELL_NUM = 4096;								//!< 空間分割のマスの最大数
+
+	/** ****************************************************************************************************
+	 * @brief 地面の線分
+	 **************************************************************************************************** */
+	struct Segment
+	{
+		Line	line;	//!< 線分
+		Vec2	normal;	//!< 法線
+
+		/** ****************************************************************************************************
+		 * @brief コンストラクタ
+		 **************************************************************************************************** */
+		inline Segment() noexcept :
+			line{ Vec2{ 0.0, 0.0 }, Vec2{ 0.0, 0.0 } },
+			normal{ Vec2{ 0.0, 0.0 } }
+		{
+
+		}
+	};
+
+	/** ****************************************************************************************************
+	 * @brief 地面の線分を一様なマスに振り分けたもの
+	 **************************************************************************************************** */
+	class Grid
+	{
+	private:
+		Array<Segment>	_aSegments;		//!< ワールド座標の線分群
+		Vec2			_origin;		//!< 左上のマスの座標
+		double			_cellSize;		//!< 1マスの大きさ
+		Size			_cellNum;		//!< マスの数
+		Array<uint32>	_aCellStarts;	//!< マスごとの線分番号の開始位置
+		Array<uint32>	_aCellIndices;	//!< マスに入っている線分番号
+
+		mutable Array<uint32>	_aStamps;	//!< 重複して返さないための印
+		mutable uint32			_stamp;		//!< 現在の印
+
+	public:
+		/** ****************************************************************************************************
+		 * @brief コンストラクタ
+		 **************************************************************************************************** */
+		Grid() noexcept;
+
+		/** ****************************************************************************************************
+		 * @brief					ワールド座標のポリゴン群から生成
+		 * @param[in] aPolygons		地面のポリゴン群
+		 * @param[in] cellSize		1マスの大きさ
+		 **************************************************************************************************** */
+		void Create(const Array<Polygon>& aPolygons, double cellSize = gDEFAULT_CELL_SIZE);
+
+		/** ****************************************************************************************************
+		 * @brief 空にする
+		 **************************************************************************************************** */
+		void Clear() noexcept;
+
+		/** ****************************************************************************************************
+		 * @brief					範囲に掛かるマスの線分を取得
+		 * @param[in] area			調べる範囲
+		 * @param[out] rIndices		線分番号(重複なし)
+		 **************************************************************************************************** */
+		void Query(const RectF& area, Array<uint32>& rIndices) const;
+
+		/** ****************************************************************************************************
+		 * @brief	全ての線分を取得
+		 * @return	線分群
+		 **************************************************************************************************** */
+		[[nodiscard]]
+		const Array<Segment>& GetSegments() const noexcept;
+
+	private:
+		/** ****************************************************************************************************
+		 * @brief				範囲に掛かるマスの番号を取得
+		 * @param[in] area		範囲
+		 * @param[out] rMin		左上のマス
+		 * @param[out] rMax		右下のマス
+		 * @retval true			一つ以上のマスに掛かった
+		 * @retval false		どのマスにも掛からなかった
+		 **************************************************************************************************** */
+		bool GetCellRange(const RectF& area, Point& rMin, Point& rMax) const noexcept;
+	};
+}
@@ -0,0 +1,49 @@
+﻿/** ****************************************************************************************************
+ * @file
+ * @brief ゲームの更新に渡す入力のデータ関連
+ **************************************************************************************************** */
+#pragma once
+
+#include <Siv3D.hpp>
+
+/** ****************************************************************************************************
+ * @brief ゲームの更新に渡す入力のデータ関連
+ **************************************************************************************************** */
+namespace MySystem::InputData
+{
+	/** ****************************************************************************************************
+	 * @brief 1フレーム分の入力の状態(ゲームの更新はこれ以外の入力を見ない)
+	 **************************************************************************************************** */
+	struct State
+	{
+		bool isLeftPressed;			//!< 左移動が押されているか
+		bool isRightPressed;		//!< 右移動が押されているか
+		bool isJumpPressed;			//!< ジャンプが押されているか
+		bool isAnyKeyPressed;		//!< いずれかのキーが押されているか
+		bool isAnyMousePressed;		//!< いずれかのマウスボタンが押されているか
+		bool isSubmitDown;			//!< 決定が押されたか
+		bool isPieceActionDown;		//!< カケラ操作が押されたか
+		bool isPieceActionUp;		//!< カケラ操作が離されたか
+		bool isRetryDown;			//!< やり直しが押されたか
+
+		Vec2 cursorPosition;		//!< カーソルの位置
+
+		/** ****************************************************************************************************
+		 * @brief コンストラクタ(何も入力していない状態)
+		 **************************************************************************************************** */
+		inline State() noexcept :
+			isLeftPressed{ false },
+			isRightPressed{ false },
+			isJumpPressed{ false },
+			isAnyKeyPressed{ false },
+			isAnyMousePressed{ false },
+			isSubmitDown{ false },
+			isPieceActionDown{ false },
+			isPieceActionUp{ false },
+			isRetryDown{ false },
+			cursorPosition{ Vec2{ 0.0, 0.0 } }
+		{
+
+		}
+	};
+}
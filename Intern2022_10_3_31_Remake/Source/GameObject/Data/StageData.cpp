@@ -3,6 +3,14 @@
  * @brief ステージのデータ操作関連
  **************************************************************************************************** */
 #include "StageData.h"
+#include "StageFile.h"
+#include "StagePack.h"
+#include "StageText.h"
+
+#include <filesystem>
+#include <list>
+#include <map>
+#include <mutex>
 
 namespace MySystem::StageData
 {
@@ -13,91 +21,847 @@ namespace MySystem::StageData
 
 	namespace
 	{
-		static const String gDATA_DIRECTORY = U"Assets/Stage/data_";	//!< データのパス
+		static const String gDATA_FOLDER = U"Assets/Stage/";				//!< データのフォルダ
+		static const String gDATA_DIRECTORY = gDATA_FOLDER + U"data_";	//!< データのパス
+
+		static constexpr size_t gDEFAULT_CACHE_BUDGET = 16 * 1024 * 1024;	//!< キャッシュに使うバイト数の初期値
+
+		/** ****************************************************************************************************
+		 * @brief キャッシュ1件分
+		 **************************************************************************************************** */
+		struct CacheEntry
+		{
+			uint16 key;								//!< ワールド番号とステージ番号から作ったキー
+			size_t byteSize;						//!< 見積もったバイト数
+			std::shared_ptr<const Desc> pDesc;		//!< 読み込み済みのデータ
+		};
+
+		std::shared_ptr<const Desc> gpDesc{ nullptr };	//!< 所持しているデータ
+		std::string gWriteBuffer;						//!< 書き込み用のバッファ(保存のたびに確保し直さないよう使い回す)
+
+		std::list<CacheEntry> gCacheEntries;									//!< 読み込み済みのデータ(先頭ほど最近使った)
+		HashTable<uint16, std::list<CacheEntry>::iterator> gCacheTable;			//!< キーからキャッシュを引く表
+		size_t gCacheBudget = gDEFAULT_CACHE_BUDGET;							//!< キャッシュに使えるバイト数
+		size_t gCacheByteSize = 0;												//!< キャッシュが使っているバイト数
+		HashTable<WorldIndex, Array<Summary>> gSummaryTable;					//!< ワールドごとのまとめファイルの索引
+		std::mutex gCacheMutex;													//!< キャッシュを別スレッドからも引けるようにする
+		Array<WorldIndex> gCatalogWorlds;										//!< 一覧にあるワールド番号
+		HashTable<WorldIndex, Array<StageIndex>> gCatalogStages;				//!< ワールドごとの一覧にあるステージ番号
+		bool gIsCatalogScanned = false;											//!< 一覧を作ったか
+
+		/** ****************************************************************************************************
+		 * @brief					キャッシュのキーを生成
+		 * @param[in] worldIndex	ワールド番号
+		 * @param[in] stageIndex	ステージ番号
+		 * @return					キー
+		 **************************************************************************************************** */
+		constexpr uint16 CreateCacheKey(const WorldIndex worldIndex, const StageIndex stageIndex) noexcept
+		{
+			return static_cast<uint16>((static_cast<uint16>(worldIndex) << 8) | stageIndex);
+		}
+
+		/** ****************************************************************************************************
+		 * @brief				データが使うおおよそのバイト数を見積もる
+		 * @param[in] desc		見積もるデータ
+		 * @return				バイト数
+		 **************************************************************************************************** */
+		size_t EstimateByteSize(const Desc& desc) noexcept
+		{
+			size_t byteSize = sizeof(Desc) + desc.stageName.size() * sizeof(char32);
+
+			for (const auto& pieceDesc : desc.aPieceDescs)
+			{
+				byteSize += sizeof(StagePieceData::Desc);
+				byteSize += pieceDesc.aTileDescs.size() * sizeof(TileData::Desc);
+				byteSize += pieceDesc.aGimmiclDesc.size() * sizeof(GimmickData::Desc);
+
+				for (const auto& hitBox : pieceDesc.aBakedHitBoxes)
+				{
+					byteSize += sizeof(Polygon) + hitBox.outer().size() * sizeof(Vec2);
+
+					for (const auto& hole : hitBox.inners())
+					{
+						byteSize += hole.size() * sizeof(Vec2);
+					}
+				}
+			}
+
+			return byteSize;
+		}
+
+		/** ****************************************************************************************************
+		 * @brief 予算に収まるまで最も使われていないものから捨てる
+		 **************************************************************************************************** */
+		void TrimCache() noexcept
+		{
+			while (gCacheBudget < gCacheByteSize && not gCacheEntries.empty())
+			{
+				const auto& entry = gCacheEntries.back();
+
+				gCacheByteSize -= entry.byteSize;
+				gCacheTable.erase(entry.key);
+				gCacheEntries.pop_back();
+			}
+		}
+
+		/** ****************************************************************************************************
+		 * @brief					キャッシュから取り出して最近使ったものにする
+		 * @param[in] key			キー
+		 * @return					データ(無ければ nullptr)
+		 **************************************************************************************************** */
+		std::shared_ptr<const Desc> FindCache(const uint16 key) noexcept
+		{
+			const auto it = gCacheTable.find(key);
+
+			if (it == gCacheTable.end())
+			{
+				return nullptr;
+			}
+
+			gCacheEntries.splice(gCacheEntries.begin(), gCacheEntries, it->second);
+
+			return it->second->pDesc;
+		}
+
+		/** ****************************************************************************************************
+		 * @brief					キャッシュに入れる(同じキーがあれば置き換える)
+		 * @param[in] key			キー
+		 * @param[in] pDesc			データ
+		 **************************************************************************************************** */
+		void StoreCache(const uint16 key, std::shared_ptr<const Desc> pDesc)
+		{
+			if (const auto it = gCacheTable.find(key); it != gCacheTable.end())
+			{
+				gCacheByteSize -= it->second->byteSize;
+				gCacheEntries.erase(it->second);
+				gCacheTable.erase(it);
+			}
+
+			const size_t byteSize = EstimateByteSize(*pDesc);
+
+			// 1件で予算を超えるものは入れても即座に捨てることになる
+			if (gCacheBudget < byteSize)
+			{
+				return;
+			}
+
+			gCacheEntries.push_front(CacheEntry{ key, byteSize, std::move(pDesc) });
+			gCacheTable[key] = gCacheEntries.begin();
+			gCacheByteSize += byteSize;
+
+			TrimCache();
+		}
+
+		/** ****************************************************************************************************
+		 * @brief					拡張子を除いたステージのパスを生成
+		 * @param[in] worldIndex	ワールド番号
+		 * @param[in] stageIndex	ステージ番号
+		 * @return					拡張子を除いたパス
+		 **************************************************************************************************** */
+		String CreateBasePath(const WorldIndex worldIndex, const StageIndex stageIndex)
+		{
+			String path = gDATA_DIRECTORY;
+
+			path += U"{:2d}"_fmt(worldIndex);
+			path += U"_";
+			path += U"{:2d}"_fmt(stageIndex);
+
+			return path;
+		}
+
+		/** ****************************************************************************************************
+		 * @brief					ワールドのまとめファイルのパスを生成
+		 * @param[in] worldIndex	ワールド番号
+		 * @return					パス
+		 **************************************************************************************************** */
+		String CreatePackPath(const WorldIndex worldIndex)
+		{
+			String path = gDATA_FOLDER;
+
+			path += U"world_";
+			path += U"{:2d}"_fmt(worldIndex);
+			path += U".";
+			path += StagePack::gEXTENSION;
+
+			return path;
+		}
+
+		/** ****************************************************************************************************
+		 * @brief					ステージのパスからワールド番号とステージ番号を取り出す
+		 * @param[in] path			ステージのパス
+		 * @param[out] rWorldIndex	ワールド番号
+		 * @param[out] rStageIndex	ステージ番号
+		 * @retval true				取り出せた
+		 * @retval false			ステージのパスの形ではなかった
+		 **************************************************************************************************** */
+		bool ParseBasePath(FilePathView path, WorldIndex& rWorldIndex, StageIndex& rStageIndex)
+		{
+			// "data_ww_ss" の形になっている
+			const auto aParts = FileSystem::BaseName(path).split(U'_');
+
+			if (aParts.size() != 3 || aParts[0] != U"data")
+			{
+				return false;
+			}
+
+			const auto worldIndex = ParseOpt<WorldIndex>(aParts[1].trimmed());
+			const auto stageIndex = ParseOpt<StageIndex>(aParts[2].trimmed());
+
+			if (not worldIndex || not stageIndex)
+			{
+				return false;
+			}
+
+			rWorldIndex = *worldIndex;
+			rStageIndex = *stageIndex;
+
+			return true;
+		}
+
+		/** ****************************************************************************************************
+		 * @brief					変換して作ったファイルが元のファイルより新しいか確認
+		 * @param[in] builtPath		変換して作ったファイルのパス
+		 * @param[in] sourcePath	元のファイルのパス
+		 * @retval true				新しい(元のファイルが無い場合も含む)
+		 * @retval false			古いか、変換して作ったファイルが無い
+		 **************************************************************************************************** */
+		bool IsUpToDate(FilePathView builtPath, FilePathView sourcePath)
+		{
+			if (not FileSystem::IsFile(builtPath))
+			{
+				return false;
+			}
+
+			const auto builtTime = FileSystem::WriteTime(builtPath);
+			const auto sourceTime = FileSystem::WriteTime(sourcePath);
+
+			return not sourceTime || (builtTime && *sourceTime <= *builtTime);
+		}
+
+		/** ****************************************************************************************************
+		 * @brief				CSV 形式のステージを読み込む(失敗した場所はログに残す)
+		 * @param[in] path		読み込むファイルのパス
+		 * @param[out] rDesc	読み込んだデータ
+		 * @retval true			読み込めた
+		 * @retval false		読み込めなかった
+		 **************************************************************************************************** */
+		bool ReadText(FilePathView path, Desc& rDesc)
+		{
+			StageText::Error error;
+
+			if (not StageText::Read(path, rDesc, error))
+			{
+				Logger << error.ToString();
+				return false;
+			}
+
+			return true;
+		}
+
+		/** ****************************************************************************************************
+		 * @brief				ステージのファイルを読み込む(拡張子で CSV か変換済みのファイルかを判断する)
+		 * @param[in] path		読み込むファイルのパス
+		 * @return				読み込んだデータ(読み込めなければ nullptr)
+		 **************************************************************************************************** */
+		std::shared_ptr<const Desc> ReadFile(FilePathView path)
+		{
+			std::shared_ptr<Desc> pDesc{ new Desc };
+
+			if (FileSystem::Extension(path) == StageFile::gEXTENSION)
+			{
+				return StageFile::Read(path, *pDesc) ? pDesc : nullptr;
+			}
+
+			if (not ReadText(path, *pDesc))
+			{
+				return nullptr;
+			}
 
-		std::shared_ptr<Desc> gpDesc{ nullptr };	//!< 所持しているデータ
+			return pDesc;
+		}
+
+		/** ****************************************************************************************************
+		 * @brief					キャッシュを見ずにファイルからステージを読み込む
+		 * @param[in] worldIndex	読み込むワールド番号
+		 * @param[in] stageIndex	読み込むステージ番号
+		 * @return					読み込んだデータ(読み込めなければ nullptr)
+		 **************************************************************************************************** */
+		std::shared_ptr<const Desc> ReadStage(const WorldIndex worldIndex, const StageIndex stageIndex)
+		{
+			const auto basePath = CreateBasePath(worldIndex, stageIndex);
+			const auto binaryPath = basePath + U"." + StageFile::gEXTENSION;
+			const auto csvPath = basePath + U"." + StageText::gEXTENSION;
+
+			// 変換済みのファイルが元の CSV より新しければそちらを使う(編集中の CSV があればそちらが優先される)
+			if (const auto packPath = CreatePackPath(worldIndex); IsUpToDate(packPath, csvPath))
+			{
+				std::shared_ptr<Desc> pDesc{ new Desc };
+
+				if (StagePack::ReadStage(packPath, stageIndex, *pDesc))
+				{
+					return pDesc;
+				}
+			}
+
+			if (IsUpToDate(binaryPath, csvPath))
+			{
+				if (auto pDesc = ReadFile(binaryPath))
+				{
+					return pDesc;
+				}
+			}
+
+			return ReadFile(csvPath);
+		}
+
+		/** ****************************************************************************************************
+		 * @brief				CSV 形式のステージを読み込んで当たり判定を事前に合成する
+		 * @param[in] csvPath	読み込むファイルのパス
+		 * @param[out] rDesc	読み込んだデータ
+		 * @retval true			読み込めた
+		 * @retval false		読み込めなかった
+		 **************************************************************************************************** */
+		bool ReadAndBake(FilePathView csvPath, Desc& rDesc)
+		{
+			if (not ReadText(csvPath, rDesc))
+			{
+				return false;
+			}
+
+			// タイルの並びは変わらないので当たり判定の合成も済ませておく
+			for (auto& rPieceDesc : rDesc.aPieceDescs)
+			{
+				rPieceDesc.aBakedHitBoxes = TileData::CreateHitBoxes(rPieceDesc.aTileDescs);
+				rPieceDesc.bakedHash = TileData::CalcuHitBoxHash(rPieceDesc.aTileDescs);
+			}
+
+			return true;
+		}
+
+		/** ****************************************************************************************************
+		 * @brief				ステージを書き出す(拡張子で CSV か変換済みのファイルかを判断する)
+		 * @param[in] desc		書き出すデータ
+		 * @param[in] path		書き出すファイルのパス
+		 * @retval true			書き出せた
+		 * @retval false		書き出せなかった
+		 **************************************************************************************************** */
+		bool WriteDesc(const Desc& desc, FilePathView path)
+		{
+			gWriteBuffer.clear();
+
+			if (FileSystem::Extension(path) == StageFile::gEXTENSION)
+			{
+				StageFile::Encode(desc, gWriteBuffer);
+			}
+			else
+			{
+				StageText::Encode(desc, gWriteBuffer);
+			}
+
+			return WriteAtomically(path, gWriteBuffer);
+		}
+
+		/** ****************************************************************************************************
+		 * @brief			ステージのデータが同じか確認(事前に合成した当たり判定も比べる)
+		 * @param[in] a		比べるデータ
+		 * @param[in] b		比べるデータ
+		 * @retval true		同じ
+		 * @retval false	違う
+		 **************************************************************************************************** */
+		bool IsSameDesc(const Desc& a, const Desc& b)
+		{
+			if (a.stageName != b.stageName || a.aPieceDescs.size() != b.aPieceDescs.size())
+			{
+				return false;
+			}
+
+			for (size_t i = 0; i < a.aPieceDescs.size(); ++i)
+			{
+				const auto& aPiece = a.aPieceDescs[i];
+				const auto& bPiece = b.aPieceDescs[i];
+
+				if (not (StagePieceData::IsSameBack(aPiece, bPiece) &&
+					StagePieceData::IsSameTiles(aPiece, bPiece) &&
+					StagePieceData::IsSameGimmicks(aPiece, bPiece)) ||
+					aPiece.bakedHash != bPiece.bakedHash ||
+					aPiece.aBakedHitBoxes.size() != bPiece.aBakedHitBoxes.size())
+				{
+					return false;
+				}
+
+				for (size_t k = 0; k < aPiece.aBakedHitBoxes.size(); ++k)
+				{
+					if (aPiece.aBakedHitBoxes[k].outer() != bPiece.aBakedHitBoxes[k].outer() ||
+						aPiece.aBakedHitBoxes[k].inners() != bPiece.aBakedHitBoxes[k].inners())
+					{
+						return false;
+					}
+				}
+			}
+
+			return true;
+		}
+
+		/** ****************************************************************************************************
+		 * @brief				変換したファイルを読み直して元のデータと比べる(一致しなければ消して配布されないようにする)
+		 * @param[in] path		変換したファイルのパス
+		 * @param[in] desc		変換元のデータ
+		 * @retval true			一致した
+		 * @retval false		読めないか一致しなかった
+		 **************************************************************************************************** */
+		bool VerifyCompiled(FilePathView path, const Desc& desc)
+		{
+			const auto pWritten = ReadFile(path);
+
+			if (pWritten && IsSameDesc(*pWritten, desc))
+			{
+				return true;
+			}
+
+			Logger << U"{} を読み直すと変換元と一致しません"_fmt(path);
+			FileSystem::Remove(path);
+			return false;
+		}
 	}
 
 	bool Load(const WorldIndex worldIndex, const StageIndex stageIndex) noexcept
 	{
-		String path = gDATA_DIRECTORY;
+		auto pDesc = Acquire(worldIndex, stageIndex);
+
+		if (not pDesc)
+		{
+			CreateDefaultData();
+			return false;
+		}
 
-		path += U"{:2d}"_fmt(worldIndex);
-		path += U"_";
-		path += U"{:2d}"_fmt(stageIndex);
-		path += U".csv";
+		gpDesc = std::move(pDesc);
+
+		return true;
+	}
+
+	bool Load(FilePathView path) noexcept
+	{
+		auto pDesc = ReadFile(path);
 
-		CSV reader{ path };
-		if (not reader) {
+		if (not pDesc)
+		{
 			CreateDefaultData();
 			return false;
 		}
 
-		gpDesc.reset(new Desc);
+		gpDesc = std::move(pDesc);
+
+		return true;
+	}
+
+	std::shared_ptr<const Desc> Acquire(const WorldIndex worldIndex, const StageIndex stageIndex) noexcept
+	{
+		const auto key = CreateCacheKey(worldIndex, stageIndex);
+
+		{
+			std::lock_guard lock{ gCacheMutex };
+
+			if (auto pDesc = FindCache(key))
+			{
+				return pDesc;
+			}
+		}
+
+		// ファイルの読み込み中は他のスレッドを待たせない
+		auto pDesc = ReadStage(worldIndex, stageIndex);
+
+		if (pDesc)
+		{
+			std::lock_guard lock{ gCacheMutex };
+
+			StoreCache(key, pDesc);
+		}
+
+		return pDesc;
+	}
+
+	std::shared_ptr<const Desc> Reload(const WorldIndex worldIndex, const StageIndex stageIndex) noexcept
+	{
+		auto pDesc = ReadStage(worldIndex, stageIndex);
+
+		// 書きかけのファイルなどで読めなければ今までのデータを使い続ける
+		if (not pDesc)
+		{
+			return nullptr;
+		}
+
+		{
+			std::lock_guard lock{ gCacheMutex };
+
+			StoreCache(CreateCacheKey(worldIndex, stageIndex), pDesc);
+			gSummaryTable.erase(worldIndex);
+		}
+
+		gpDesc = pDesc;
+
+		return pDesc;
+	}
+
+	FilePathView GetDataFolder() noexcept
+	{
+		return gDATA_FOLDER;
+	}
+
+	bool IsStagePath(FilePathView path, const WorldIndex worldIndex, const StageIndex stageIndex)
+	{
+		if (FileSystem::FullPath(path) == FileSystem::FullPath(CreatePackPath(worldIndex)))
+		{
+			return true;
+		}
+
+		const auto extension = FileSystem::Extension(path);
+
+		if (extension != StageText::gEXTENSION && extension != StageFile::gEXTENSION)
+		{
+			return false;
+		}
+
+		WorldIndex pathWorldIndex = 0;
+		StageIndex pathStageIndex = 0;
 
-		gpDesc->stageName = reader[0][0];
+		return ParseBasePath(path, pathWorldIndex, pathStageIndex) &&
+			pathWorldIndex == worldIndex && pathStageIndex == stageIndex;
+	}
 
-		size_t index = 2;
-		for (size_t i = 0, max = Parse<size_t>(reader[1][0]); i < max; ++i)
+	bool Compile(FilePathView csvPath, FilePathView binaryPath) noexcept
+	{
+		Desc desc;
+
+		if (not ReadAndBake(csvPath, desc))
 		{
-			auto& pieceData = gpDesc->aPieceDescs.emplace_back();
+			return false;
+		}
 
-			pieceData.position.x = Parse<double>(reader[index][0]);
-			pieceData.position.y = Parse<double>(reader[index][1]);
-			pieceData.scale = Parse<double>(reader[index][2]);
-			pieceData.angle = Parse<double>(reader[index][3]);
-			pieceData.backScale = Parse<Vec2>(reader[index][4]);
+		return WriteDesc(desc, binaryPath) && VerifyCompiled(binaryPath, desc);
+	}
 
-			pieceData.canMoving = Parse<bool>(reader[index + 1][0]);
-			pieceData.canScaling = Parse<bool>(reader[index + 1][1]);
-			pieceData.canRolling = Parse<bool>(reader[index + 1][2]);
-			pieceData.backType = Parse<StagePieceData::TypeIndex>(reader[index + 1][3]);
+	size_t CompileAll() noexcept
+	{
+		size_t compiledNum = 0;
+		std::map<WorldIndex, Array<StagePack::Source>> aWorldSources;
 
-			index += 3;
-			for (size_t t = 0, tMax = Parse<size_t>(reader[index - 1][0]); t < tMax; ++t)
+		for (const auto& path : FileSystem::DirectoryContents(gDATA_FOLDER, Recursive::No))
+		{
+			if (FileSystem::Extension(path) != StageText::gEXTENSION)
 			{
-				auto& tileData = pieceData.aTileDescs.emplace_back();
+				continue;
+			}
 
-				tileData.position.x = Parse<double>(reader[index][0]);
-				tileData.position.y = Parse<double>(reader[index][1]);
-				tileData.angle = Parse<double>(reader[index][2]);
-				tileData.tileType = Parse<TileData::TypeIndex>(reader[index][3]);
-				tileData.uv.x = Parse<double>(reader[index][4]);
-				tileData.uv.y = Parse<double>(reader[index][5]);
+			Desc desc;
 
-				index++;
+			if (not ReadAndBake(path, desc))
+			{
+				continue;
 			}
 
-			index += 1;
-			for (size_t g = 0, gMax = Parse<size_t>(reader[index - 1][0]); g < gMax; ++g)
+			const auto binaryPath = FileSystem::ParentPath(path) + FileSystem::BaseName(path) + U"." + StageFile::gEXTENSION;
+
+			if (not (WriteDesc(desc, binaryPath) && VerifyCompiled(binaryPath, desc)))
 			{
-				auto& gimmickData = pieceData.aGimmiclDesc.emplace_back();
+				continue;
+			}
 
-				gimmickData.position.x = Parse<double>(reader[index][0]);
-				gimmickData.position.y = Parse<double>(reader[index][1]);
-				gimmickData.angle = Parse<double>(reader[index][2]);
-				gimmickData.gimmickType = Parse<GimmickData::TypeIndex>(reader[index][3]);
+			++compiledNum;
 
-				index++;
+			WorldIndex worldIndex = 0;
+			StageIndex stageIndex = 0;
+
+			if (ParseBasePath(path, worldIndex, stageIndex))
+			{
+				aWorldSources[worldIndex].push_back(StagePack::Source{ stageIndex, std::move(desc) });
 			}
 		}
 
-		return true;
+		// ワールドごとに1つのファイルにまとめる
+		for (const auto& [worldIndex, aSources] : aWorldSources)
+		{
+			const auto packPath = CreatePackPath(worldIndex);
+
+			if (not StagePack::Write(aSources, packPath))
+			{
+				Logger << U"{} を書き出せませんでした"_fmt(packPath);
+				continue;
+			}
+
+			// 索引の概要とステージ本体がどちらも元のデータと一致するか確かめる
+			Array<Summary> aSummaries;
+			bool isValid = StagePack::ReadIndex(packPath, aSummaries);
+
+			for (const auto& source : aSources)
+			{
+				Desc packDesc;
+
+				isValid = isValid &&
+					source.stageIndex < aSummaries.size() &&
+					aSummaries[source.stageIndex].isExist &&
+					aSummaries[source.stageIndex].stageName == source.desc.stageName &&
+					StagePack::ReadStage(packPath, source.stageIndex, packDesc) &&
+					IsSameDesc(packDesc, source.desc);
+			}
+
+			if (not isValid)
+			{
+				Logger << U"{} を読み直すと変換元と一致しません"_fmt(packPath);
+				FileSystem::Remove(packPath);
+			}
+		}
+
+		return compiledNum;
 	}
 
 	bool Save(const WorldIndex worldIndex, const StageIndex stageIndex) noexcept
 	{
-		String path = gDATA_DIRECTORY;
+		if (not Save(CreateBasePath(worldIndex, stageIndex) + U"." + StageText::gEXTENSION))
+		{
+			return false;
+		}
+
+		std::lock_guard lock{ gCacheMutex };
+
+		StoreCache(CreateCacheKey(worldIndex, stageIndex), gpDesc);
+
+		return true;
+	}
+
+	bool Save(FilePathView path) noexcept
+	{
+		if (not gpDesc)
+		{
+			return false;
+		}
+
+		return WriteDesc(*gpDesc, path);
+	}
+
+	bool WriteAtomically(FilePathView path, const std::string& buffer) noexcept
+	{
+		FilePath tempPath{ path };
+		tempPath += U".tmp";
+
+		{
+			BinaryWriter writer{ tempPath };
+
+			if (not writer)
+			{
+				return false;
+			}
+
+			if (writer.write(buffer.data(), static_cast<int64>(buffer.size())) != static_cast<int64>(buffer.size()))
+			{
+				writer.close();
+				FileSystem::Remove(tempPath);
+				return false;
+			}
+		}
+
+		// 置き換え先が既にあっても 1 回の操作で入れ替える
+		std::error_code error;
+		std::filesystem::rename(Unicode::ToWstring(tempPath), Unicode::ToWstring(path), error);
+
+		if (error)
+		{
+			FileSystem::Remove(tempPath);
+			return false;
+		}
+
+		return true;
+	}
+
+	void SetCacheBudget(const size_t byteSize) noexcept
+	{
+		std::lock_guard lock{ gCacheMutex };
+
+		gCacheBudget = byteSize;
+
+		TrimCache();
+	}
+
+	void ClearCache() noexcept
+	{
+		std::lock_guard lock{ gCacheMutex };
+
+		gCacheEntries.clear();
+		gCacheTable.clear();
+		gCacheByteSize = 0;
+		gSummaryTable.clear();
+	}
+
+	Optional<Summary> GetSummary(const WorldIndex worldIndex, const StageIndex stageIndex) noexcept
+	{
+		auto findSummary = [stageIndex](const Array<Summary>& aSummaries) -> Optional<Summary>
+		{
+			if (stageIndex < aSummaries.size() && aSummaries[stageIndex].isExist)
+			{
+				return aSummaries[stageIndex];
+			}
+
+			return none;
+		};
 
-		path += U"{:2d}"_fmt(worldIndex);
-		path += U"_";
-		path += U"{:2d}"_fmt(stageIndex);
-		path += U".csv";
+		Optional<Summary> summaryOpt;
+		bool isIndexCached = false;
+
+		{
+			std::lock_guard lock{ gCacheMutex };
+
+			if (const auto itr = gSummaryTable.find(worldIndex); itr != gSummaryTable.end())
+			{
+				summaryOpt = findSummary(itr->second);
+				isIndexCached = true;
+			}
+		}
+
+		if (not isIndexCached)
+		{
+			// 読み込みはロックの外で行い、他のスレッドを待たせない
+			Array<Summary> aSummaries;
+
+			if (not StagePack::ReadIndex(CreatePackPath(worldIndex), aSummaries))
+			{
+				aSummaries.clear();
+			}
 
-		return false;
+			std::lock_guard lock{ gCacheMutex };
+
+			// まとめファイルが無くても空の索引を入れて何度も探さないようにする(先に入れられていたらそちらを使う)
+			const auto itr = gSummaryTable.try_emplace(worldIndex, std::move(aSummaries)).first;
+
+			summaryOpt = findSummary(itr->second);
+		}
+
+		if (summaryOpt)
+		{
+			return summaryOpt;
+		}
+
+		// まとめファイルに無ければステージ本体を読む
+		const auto pDesc = Acquire(worldIndex, stageIndex);
+
+		if (not pDesc)
+		{
+			return none;
+		}
+
+		Summary summary;
+		summary.stageName = pDesc->stageName;
+		summary.pieceNum = static_cast<uint32>(pDesc->aPieceDescs.size());
+		summary.isExist = true;
+
+		for (const auto& pieceDesc : pDesc->aPieceDescs)
+		{
+			summary.tileNum += static_cast<uint32>(pieceDesc.aTileDescs.size());
+		}
+
+		return summary;
 	}
 
-	std::shared_ptr<Desc> GetCurrentData()
+	size_t ScanCatalog() noexcept
+	{
+		std::map<WorldIndex, Array<StageIndex>> aWorldStages;
+		HashTable<WorldIndex, Array<Summary>> aPackSummaries;
+
+		// ファイル名から番号が分かるので、ステージ本体は遊ぶ時まで読まない
+		for (const auto& path : FileSystem::DirectoryContents(gDATA_FOLDER, Recursive::No))
+		{
+			const auto extension = FileSystem::Extension(path);
+
+			if (extension == StagePack::gEXTENSION)
+			{
+				const auto aParts = FileSystem::BaseName(path).split(U'_');
+				const auto worldIndex = (aParts.size() == 2 && aParts[0] == U"world") ? ParseOpt<WorldIndex>(aParts[1].trimmed()) : none;
+				Array<Summary> aSummaries;
+
+				if (not worldIndex || not StagePack::ReadIndex(path, aSummaries))
+				{
+					continue;
+				}
+
+				auto& rStages = aWorldStages[*worldIndex];
+
+				for (size_t i = 0; i < aSummaries.size(); ++i)
+				{
+					if (aSummaries[i].isExist)
+					{
+						rStages.push_back(static_cast<StageIndex>(i));
+					}
+				}
+
+				aPackSummaries.emplace(*worldIndex, std::move(aSummaries));
+				continue;
+			}
+
+			if (extension != StageText::gEXTENSION && extension != StageFile::gEXTENSION)
+			{
+				continue;
+			}
+
+			WorldIndex worldIndex = 0;
+			StageIndex stageIndex = 0;
+
+			if (ParseBasePath(path, worldIndex, stageIndex))
+			{
+				aWorldStages[worldIndex].push_back(stageIndex);
+			}
+		}
+
+		size_t stageNum = 0;
+
+		gCatalogWorlds.clear();
+		gCatalogStages.clear();
+
+		for (auto& [worldIndex, aStages] : aWorldStages)
+		{
+			// CSV、変換済み、まとめファイルで同じステージが何度も見つかる
+			aStages.sort_and_unique();
+			stageNum += aStages.size();
+
+			gCatalogWorlds.push_back(worldIndex);
+			gCatalogStages.emplace(worldIndex, std::move(aStages));
+		}
+
+		gIsCatalogScanned = true;
+
+		// 読んだ索引は概要の取得に使い回す
+		std::lock_guard lock{ gCacheMutex };
+
+		for (auto& [worldIndex, aSummaries] : aPackSummaries)
+		{
+			gSummaryTable[worldIndex] = std::move(aSummaries);
+		}
+
+		return stageNum;
+	}
+
+	const Array<WorldIndex>& GetCatalogWorlds() noexcept
+	{
+		if (not gIsCatalogScanned)
+		{
+			ScanCatalog();
+		}
+
+		return gCatalogWorlds;
+	}
+
+	const Array<StageIndex>& GetCatalogStages(const WorldIndex worldIndex) noexcept
+	{
+		static const Array<StageIndex> EMPTY;
+
+		if (not gIsCatalogScanned)
+		{
+			ScanCatalog();
+		}
+
+		const auto itr = gCatalogStages.find(worldIndex);
+
+		return (itr == gCatalogStages.end()) ? EMPTY : itr->second;
+	}
+
+	std::shared_ptr<const Desc> GetCurrentData()
 	{
 		// オブジェクト生成に使用することが考慮されるためデータがない場合大変危険である
 		if (not gpDesc)
@@ -110,15 +874,15 @@ namespace MySystem::StageData
 
 	void CreateDefaultData()
 	{
-		gpDesc.reset(new Desc);
+		std::shared_ptr<Desc> pDesc{ new Desc };
 
-		gpDesc->stageName = U"デフォルト";
+		pDesc->stageName = U"デフォルト";
 
-		gpDesc->aPieceDescs.resize(5);
+		pDesc->aPieceDescs.resize(5);
 		auto tileSize = Vec2{ TileData::gTILE_SIZE, TileData::gTILE_SIZE };
 
 		{
-			auto& rPieceDesc = gpDesc->aPieceDescs[0];
+			auto& rPieceDesc = pDesc->aPieceDescs[0];
 
 			rPieceDesc.backType = static_cast<StagePieceData::TypeIndex>(StagePieceData::Type::Normal);
 			rPieceDesc.backScale = tileSize * 10.0;
@@ -134,42 +898,39 @@ namespace MySystem::StageData
 			for (size_t i = 0; i < 10; ++i)
 			{
 				auto& tile = rPieceDesc.aTileDescs.emplace_back();
-				tile.uv.x = 8;
-				tile.position.x = leftTop.x + tileSize.x * static_cast<double>(i);
-				tile.position.y = leftTop.y + tileSize.y * 9.0;
+				tile.SetUV(Point{ 8, 0 });
+				tile.SetPosition(Vec2{ leftTop.x + tileSize.x * static_cast<double>(i), leftTop.y + tileSize.y * 9.0 });
 			}
 
 			for (size_t i = 6; i < 10; i++)
 			{
 				auto& tile = rPieceDesc.aTileDescs.emplace_back();
-				tile.uv.x = 8;
-				tile.position.x = leftTop.x + tileSize.x * 5.0;
-				tile.position.y = leftTop.y + tileSize.y * static_cast<double>(i);
+				tile.SetUV(Point{ 8, 0 });
+				tile.SetPosition(Vec2{ leftTop.x + tileSize.x * 5.0, leftTop.y + tileSize.y * static_cast<double>(i) });
 			}
 
 			{
 				auto& tile = rPieceDesc.aTileDescs.emplace_back();
 				tile.tileType = static_cast<TileData::TypeIndex>(TileData::Type::Triangle);
-				tile.uv.x = 8;
-				tile.uv.y = 1;
-				tile.position = Vec2{ leftTop.x + tileSize.x * 4.0, leftTop.y + tileSize.y * 8.0 };
+				tile.SetUV(Point{ 8, 1 });
+				tile.SetPosition(Vec2{ leftTop.x + tileSize.x * 4.0, leftTop.y + tileSize.y * 8.0 });
 			}
 
 			{
 				auto& gimmick = rPieceDesc.aGimmiclDesc.emplace_back();
 				gimmick.gimmickType = static_cast<GimmickData::TypeIndex>(GimmickData::Type::Player);
-				gimmick.position = Vec2{ leftTop.x + tileSize.x * 1, leftTop.y + tileSize.y * 8 };
+				gimmick.SetPosition(Vec2{ leftTop.x + tileSize.x * 1, leftTop.y + tileSize.y * 8 });
 			}
 
 			{
 				auto& gimmick = rPieceDesc.aGimmiclDesc.emplace_back();
 				gimmick.gimmickType = static_cast<GimmickData::TypeIndex>(GimmickData::Type::Goal);
-				gimmick.position = Vec2{ leftTop.x + tileSize.x * 8, leftTop.y + tileSize.y * 8 };
+				gimmick.SetPosition(Vec2{ leftTop.x + tileSize.x * 8, leftTop.y + tileSize.y * 8 });
 			}
 		}
 
 		{
-			auto& rPieceDesc = gpDesc->aPieceDescs[1];
+			auto& rPieceDesc = pDesc->aPieceDescs[1];
 
 			rPieceDesc.backType = static_cast<StagePieceData::TypeIndex>(StagePieceData::Type::Normal);
 			rPieceDesc.backScale.x = tileSize.x * 8.0;
@@ -190,15 +951,14 @@ namespace MySystem::StageData
 				for (size_t y = 0; y < 6; y++)
 				{
 					auto& tile = rPieceDesc.aTileDescs.emplace_back();
-					tile.uv.x = static_cast<int32>(x);
-					tile.uv.y = static_cast<int32>(y);
-					tile.position = Vec2{ leftTop.x + tileSize.x * static_cast<double>(x), leftTop.y + tileSize.y * static_cast<double>(y) };
+					tile.SetUV(Point{ static_cast<int32>(x), static_cast<int32>(y) });
+					tile.SetPosition(Vec2{ leftTop.x + tileSize.x * static_cast<double>(x), leftTop.y + tileSize.y * static_cast<double>(y) });
 				}
 			}
 		}
 
 		{
-			auto& rPieceDesc = gpDesc->aPieceDescs[2];
+			auto& rPieceDesc = pDesc->aPieceDescs[2];
 
 			rPieceDesc.backType = static_cast<StagePieceData::TypeIndex>(StagePieceData::Type::Normal);
 			rPieceDesc.backScale.x = tileSize.x * 7.0;
@@ -219,15 +979,14 @@ namespace MySystem::StageData
 				for (size_t y = 0; y < 6; y++)
 				{
 					auto& tile = rPieceDesc.aTileDescs.emplace_back();
-					tile.uv.x = static_cast<int32>(x + 9);
-					tile.uv.y = static_cast<int32>(y);
-					tile.position = Vec2{ leftTop.x + tileSize.x * static_cast<double>(x), leftTop.y + tileSize.y * static_cast<double>(y) };
+					tile.SetUV(Point{ static_cast<int32>(x + 9), static_cast<int32>(y) });
+					tile.SetPosition(Vec2{ leftTop.x + tileSize.x * static_cast<double>(x), leftTop.y + tileSize.y * static_cast<double>(y) });
 				}
 			}
 		}
 
 		{
-			auto& rPieceDesc = gpDesc->aPieceDescs[3];
+			auto& rPieceDesc = pDesc->aPieceDescs[3];
 
 			rPieceDesc.backType = static_cast<StagePieceData::TypeIndex>(StagePieceData::Type::Gravity);
 			rPieceDesc.backScale.x = tileSize.x * 6.0;
@@ -246,13 +1005,13 @@ namespace MySystem::StageData
 			for (size_t x = 0; x < 6; x++)
 			{
 				auto& tile = rPieceDesc.aTileDescs.emplace_back();
-				tile.uv.x = static_cast<int32>(8);
-				tile.position = Vec2{ leftTop.x + tileSize.x * static_cast<double>(x), leftTop.y + tileSize.y * 2.0 };
+				tile.SetUV(Point{ 8, 0 });
+				tile.SetPosition(Vec2{ leftTop.x + tileSize.x * static_cast<double>(x), leftTop.y + tileSize.y * 2.0 });
 			}
 		}
 
 		{
-			auto& rPieceDesc = gpDesc->aPieceDescs[4];
+			auto& rPieceDesc = pDesc->aPieceDescs[4];
 
 			rPieceDesc.backType = static_cast<StagePieceData::TypeIndex>(StagePieceData::Type::Void);
 			rPieceDesc.backScale.x = tileSize.x * 6.0;
@@ -271,9 +1030,11 @@ namespace MySystem::StageData
 			for (size_t x = 0; x < 6; x++)
 			{
 				auto& tile = rPieceDesc.aTileDescs.emplace_back();
-				tile.uv.x = static_cast<int32>(8);
-				tile.position = Vec2{ leftTop.x + tileSize.x * static_cast<double>(x), leftTop.y + tileSize.y * 2.0 };
+				tile.SetUV(Point{ 8, 0 });
+				tile.SetPosition(Vec2{ leftTop.x + tileSize.x * static_cast<double>(x), leftTop.y + tileSize.y * 2.0 });
 			}
 		}
+
+		gpDesc = std::move(pDesc);
 	}
 }
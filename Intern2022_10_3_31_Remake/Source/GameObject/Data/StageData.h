@@ -33,7 +33,30 @@ namespace MySystem::StageData
 	};
 
 	/** ****************************************************************************************************
-	 * @brief					ステージの読み込み
+	 * @brief ステージ本体を読まずに分かるステージの概要
+	 **************************************************************************************************** */
+	struct Summary
+	{
+		String stageName;	//!< ステージ名(名前の無いステージもある)
+		uint32 pieceNum;	//!< カケラの数
+		uint32 tileNum;		//!< 全てのカケラのタイルの数
+		bool isExist;		//!< ステージがあるか(まとめファイルの索引で番号が飛んでいる所は false)
+
+		/** ****************************************************************************************************
+		 * @brief コンストラクタ
+		 **************************************************************************************************** */
+		inline Summary() noexcept :
+			stageName{},
+			pieceNum{ 0 },
+			tileNum{ 0 },
+			isExist{ false }
+		{
+
+		}
+	};
+
+	/** ****************************************************************************************************
+	 * @brief					ステージの読み込み(一度読み込んだものはキャッシュから取り出す)
 	 * @param[in] worldIndex	読み込むワールド番号
 	 * @param[in] stageIndex	読み込むステージ番号
 	 * @retval true				読み込めた
@@ -42,7 +65,62 @@ namespace MySystem::StageData
 	bool Load(const WorldIndex worldIndex, const StageIndex stageIndex) noexcept;
 
 	/** ****************************************************************************************************
-	 * @brief					ステージの書き込み
+	 * @brief				ステージの読み込み(拡張子で CSV か変換済みのファイルかを判断する)
+	 * @param[in] path		読み込むファイルのパス
+	 * @retval true			読み込めた
+	 * @retval false		読み込めなかった
+	 **************************************************************************************************** */
+	bool Load(FilePathView path) noexcept;
+
+	/** ****************************************************************************************************
+	 * @brief					ステージのデータを取得(現在のデータは変えないので別スレッドからも呼べる)
+	 * @param[in] worldIndex	取得するワールド番号
+	 * @param[in] stageIndex	取得するステージ番号
+	 * @return					ステージのデータ(読み込めなければ nullptr)
+	 **************************************************************************************************** */
+	std::shared_ptr<const Desc> Acquire(const WorldIndex worldIndex, const StageIndex stageIndex) noexcept;
+
+	/** ****************************************************************************************************
+	 * @brief					キャッシュを捨ててファイルから読み直し、現在のデータにする
+	 * @param[in] worldIndex	読み直すワールド番号
+	 * @param[in] stageIndex	読み直すステージ番号
+	 * @return					読み直したデータ(読み込めなければ nullptr で、現在のデータは変えない)
+	 **************************************************************************************************** */
+	std::shared_ptr<const Desc> Reload(const WorldIndex worldIndex, const StageIndex stageIndex) noexcept;
+
+	/** ****************************************************************************************************
+	 * @brief	ステージのファイルを置くフォルダを取得
+	 * @return	フォルダのパス
+	 **************************************************************************************************** */
+	FilePathView GetDataFolder() noexcept;
+
+	/** ****************************************************************************************************
+	 * @brief					ステージの読み込みに使われるファイルか確認(CSV、変換済み、まとめファイル)
+	 * @param[in] path			確認するファイルのパス
+	 * @param[in] worldIndex	ワールド番号
+	 * @param[in] stageIndex	ステージ番号
+	 * @retval true				使われる
+	 * @retval false			使われない
+	 **************************************************************************************************** */
+	bool IsStagePath(FilePathView path, const WorldIndex worldIndex, const StageIndex stageIndex);
+
+	/** ****************************************************************************************************
+	 * @brief					CSV 形式のステージを変換済みのステージファイルに変換する(カケラの当たり判定も事前に合成する)
+	 * @param[in] csvPath		変換元の CSV のパス
+	 * @param[in] binaryPath	書き出すファイルのパス
+	 * @retval true				変換できた
+	 * @retval false			変換できなかった
+	 **************************************************************************************************** */
+	bool Compile(FilePathView csvPath, FilePathView binaryPath) noexcept;
+
+	/** ****************************************************************************************************
+	 * @brief	ステージのフォルダにある全ての CSV を隣に変換し、ワールドごとのまとめファイルも作る
+	 * @return	変換できたファイルの数
+	 **************************************************************************************************** */
+	size_t CompileAll() noexcept;
+
+	/** ****************************************************************************************************
+	 * @brief					ステージの書き込み(書き込めたらキャッシュも更新する)
 	 * @param[in] worldIndex	書き込むワールド番号
 	 * @param[in] stageIndex	書き込むステージ番号
 	 * @retval true				書き込めた
@@ -51,10 +129,65 @@ namespace MySystem::StageData
 	bool Save(const WorldIndex worldIndex, const StageIndex stageIndex) noexcept;
 
 	/** ****************************************************************************************************
-	 * @brief	現在読み込んでいるデータを取得
+	 * @brief				ステージの書き込み(拡張子で CSV か変換済みのファイルかを判断する)
+	 * @param[in] path		書き込むファイルのパス
+	 * @retval true			書き込めた
+	 * @retval false		書き込めなかった
+	 **************************************************************************************************** */
+	bool Save(FilePathView path) noexcept;
+
+	/** ****************************************************************************************************
+	 * @brief				一時ファイルに書き出してから置き換える(途中で失敗しても元のファイルは壊れない)
+	 * @param[in] path		書き出すファイルのパス
+	 * @param[in] buffer	書き出す内容
+	 * @retval true			書き出せた
+	 * @retval false		書き出せなかった
+	 **************************************************************************************************** */
+	bool WriteAtomically(FilePathView path, const std::string& buffer) noexcept;
+
+	/** ****************************************************************************************************
+	 * @brief					キャッシュに使うバイト数を設定(超えた分は最も使われていないものから捨てる)
+	 * @param[in] byteSize		キャッシュに使えるバイト数
+	 **************************************************************************************************** */
+	void SetCacheBudget(const size_t byteSize) noexcept;
+
+	/** ****************************************************************************************************
+	 * @brief キャッシュを全て捨てる
+	 **************************************************************************************************** */
+	void ClearCache() noexcept;
+
+	/** ****************************************************************************************************
+	 * @brief					ステージの概要を取得(まとめファイルがあれば索引だけを読む)
+	 * @param[in] worldIndex	取得するワールド番号
+	 * @param[in] stageIndex	取得するステージ番号
+	 * @return					ステージの概要(ステージが無ければ none)
+	 **************************************************************************************************** */
+	Optional<Summary> GetSummary(const WorldIndex worldIndex, const StageIndex stageIndex) noexcept;
+
+	/** ****************************************************************************************************
+	 * @brief	ステージのフォルダを走査して遊べるステージの一覧を作る(ステージ本体は読まず、まとめファイルは索引だけを読む)
+	 * @return	見つかったステージの数
+	 **************************************************************************************************** */
+	size_t ScanCatalog() noexcept;
+
+	/** ****************************************************************************************************
+	 * @brief	一覧にあるワールド番号を取得(一覧が無ければ作る)
+	 * @return	小さい順のワールド番号
+	 **************************************************************************************************** */
+	const Array<WorldIndex>& GetCatalogWorlds() noexcept;
+
+	/** ****************************************************************************************************
+	 * @brief					一覧にあるステージ番号を取得(一覧が無ければ作る)
+	 * @param[in] worldIndex	ワールド番号
+	 * @return					小さい順のステージ番号(ワールドが無ければ空)
+	 **************************************************************************************************** */
+	const Array<StageIndex>& GetCatalogStages(const WorldIndex worldIndex) noexcept;
+
+	/** ****************************************************************************************************
+	 * @brief	現在読み込んでいるデータを取得(キャッシュと共有しているので書き換えられない)
 	 * @return	現在読み込んでいるデータ
 	 **************************************************************************************************** */
-	std::shared_ptr<Desc> GetCurrentData();
+	std::shared_ptr<const Desc> GetCurrentData();
 }
 
 
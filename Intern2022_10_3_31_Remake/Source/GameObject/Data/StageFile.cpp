@@ -0,0 +1,387 @@
+﻿/** ****************************************************************************************************
+ * @file
+ * @brief 変換済みのステージファイル関連
+ **************************************************************************************************** */
+#include "StageFile.h"
+
+namespace MySystem::StageFile
+{
+	namespace
+	{
+		// 各表をヘッダの直後から詰めて並べても揃えが崩れないようにしておく
+		static_assert(sizeof(Header) % gRECORD_ALIGNMENT == 0);
+		static_assert(sizeof(PieceRecord) % gRECORD_ALIGNMENT == 0);
+		static_assert(sizeof(TileRecord) % gRECORD_ALIGNMENT == 0);
+		static_assert(sizeof(GimmickRecord) % gRECORD_ALIGNMENT == 0);
+		static_assert(sizeof(PolygonRecord) % gRECORD_ALIGNMENT == 0);
+		static_assert(sizeof(RingRecord) % gRECORD_ALIGNMENT == 0);
+		static_assert(sizeof(VertexRecord) % gRECORD_ALIGNMENT == 0);
+
+		/** ****************************************************************************************************
+		 * @brief					表がファイルに収まっているか確認
+		 * @param[in] offset		表の位置
+		 * @param[in] size			表のバイト数
+		 * @param[in] fileSize		ファイルのバイト数
+		 * @retval true				収まっている
+		 * @retval false			はみ出している
+		 **************************************************************************************************** */
+		bool IsInside(const uint64 offset, const uint64 size, const uint64 fileSize) noexcept
+		{
+			return offset <= fileSize && size <= fileSize - offset;
+		}
+
+		/** ****************************************************************************************************
+		 * @brief					表がファイルに収まっていて、そのまま読める位置にあるか確認
+		 * @param[in] offset		表の位置
+		 * @param[in] size			表のバイト数
+		 * @param[in] fileSize		ファイルのバイト数
+		 * @retval true				読める
+		 * @retval false			読めない
+		 **************************************************************************************************** */
+		bool IsReadableTable(const uint64 offset, const uint64 size, const uint64 fileSize) noexcept
+		{
+			return offset % gRECORD_ALIGNMENT == 0 && IsInside(offset, size, fileSize);
+		}
+
+		/** ****************************************************************************************************
+		 * @brief					頂点表の一部を頂点群にする
+		 * @param[in] pVertices		頂点表
+		 * @param[in] begin			開始位置
+		 * @param[in] num			頂点の数
+		 * @return					頂点群
+		 **************************************************************************************************** */
+		Array<Vec2> ReadVertices(const VertexRecord* pVertices, const uint32 begin, const uint32 num)
+		{
+			Array<Vec2> aVertices(num);
+
+			for (uint32 i = 0; i < num; ++i)
+			{
+				aVertices[i] = Vec2{ pVertices[begin + i].x, pVertices[begin + i].y };
+			}
+
+			return aVertices;
+		}
+
+		/** ****************************************************************************************************
+		 * @brief					頂点群を頂点表に書き込む
+		 * @param[in] aVertices		頂点群
+		 * @param[out] pVertices	頂点表
+		 * @param[in,out] rIndex	書き込む位置(書き込んだ分だけ進む)
+		 **************************************************************************************************** */
+		void WriteVertices(const Array<Vec2>& aVertices, uint8* pVertices, uint32& rIndex)
+		{
+			for (const auto& vertex : aVertices)
+			{
+				const VertexRecord record{ vertex.x, vertex.y };
+				std::memcpy(pVertices + static_cast<size_t>(rIndex) * sizeof(VertexRecord), &record, sizeof(VertexRecord));
+
+				++rIndex;
+			}
+		}
+	}
+
+	bool Read(FilePathView path, StageData::Desc& rDesc)
+	{
+		MemoryMappedFileView file{ path };
+
+		if (not file)
+		{
+			return false;
+		}
+
+		const auto memory = file.map();
+
+		if (memory.data == nullptr)
+		{
+			return false;
+		}
+
+		return Decode(memory.data, memory.size, rDesc);
+	}
+
+	bool Decode(const void* pData, const size_t size, StageData::Desc& rDesc)
+	{
+		if (pData == nullptr || size < sizeof(Header))
+		{
+			return false;
+		}
+
+		const auto pBytes = reinterpret_cast<const uint8*>(pData);
+		const auto& header = *reinterpret_cast<const Header*>(pBytes);
+
+		if (header.magic != gMAGIC || header.version != gVERSION)
+		{
+			return false;
+		}
+
+		if (not IsReadableTable(header.pieceOffset, static_cast<uint64>(header.pieceNum) * sizeof(PieceRecord), size) ||
+			not IsReadableTable(header.tileOffset, static_cast<uint64>(header.tileNum) * sizeof(TileRecord), size) ||
+			not IsReadableTable(header.gimmickOffset, static_cast<uint64>(header.gimmickNum) * sizeof(GimmickRecord), size) ||
+			not IsReadableTable(header.polygonOffset, static_cast<uint64>(header.polygonNum) * sizeof(PolygonRecord), size) ||
+			not IsReadableTable(header.ringOffset, static_cast<uint64>(header.ringNum) * sizeof(RingRecord), size) ||
+			not IsReadableTable(header.vertexOffset, static_cast<uint64>(header.vertexNum) * sizeof(VertexRecord), size) ||
+			not IsInside(header.nameOffset, header.nameSize, size))
+		{
+			return false;
+		}
+
+		// 割り当てたメモリを表としてそのまま読む
+		const auto pPieces = reinterpret_cast<const PieceRecord*>(pBytes + header.pieceOffset);
+		const auto pTiles = reinterpret_cast<const TileRecord*>(pBytes + header.tileOffset);
+		const auto pGimmicks = reinterpret_cast<const GimmickRecord*>(pBytes + header.gimmickOffset);
+		const auto pPolygons = reinterpret_cast<const PolygonRecord*>(pBytes + header.polygonOffset);
+		const auto pRings = reinterpret_cast<const RingRecord*>(pBytes + header.ringOffset);
+		const auto pVertices = reinterpret_cast<const VertexRecord*>(pBytes + header.vertexOffset);
+
+		StageData::Desc desc;
+
+		desc.stageName = Unicode::FromUTF8(std::string_view{ reinterpret_cast<const char*>(pBytes + header.nameOffset), header.nameSize });
+		desc.aPieceDescs.resize(header.pieceNum);
+
+		for (uint32 i = 0; i < header.pieceNum; ++i)
+		{
+			const auto& piece = pPieces[i];
+			auto& rPieceDesc = desc.aPieceDescs[i];
+
+			if (static_cast<uint64>(piece.tileBegin) + piece.tileNum > header.tileNum ||
+				static_cast<uint64>(piece.gimmickBegin) + piece.gimmickNum > header.gimmickNum ||
+				static_cast<uint64>(piece.polygonBegin) + piece.polygonNum > header.polygonNum ||
+				static_cast<StagePieceData::TypeIndex>(StagePieceData::Type::Max) <= piece.backType)
+			{
+				return false;
+			}
+
+			rPieceDesc.position = Vec2{ piece.positionX, piece.positionY };
+			rPieceDesc.scale = piece.scale;
+			rPieceDesc.angle = piece.angle;
+			rPieceDesc.backScale = Vec2{ piece.backScaleX, piece.backScaleY };
+			rPieceDesc.canMoving = (piece.canMoving != 0);
+			rPieceDesc.canScaling = (piece.canScaling != 0);
+			rPieceDesc.canRolling = (piece.canRolling != 0);
+			rPieceDesc.backType = piece.backType;
+
+			rPieceDesc.aTileDescs.resize(piece.tileNum);
+			for (uint32 t = 0; t < piece.tileNum; ++t)
+			{
+				const auto& tile = pTiles[piece.tileBegin + t];
+				auto& rTileDesc = rPieceDesc.aTileDescs[t];
+
+				if (static_cast<uint8>(TileData::Turn::Max) <= tile.turn ||
+					static_cast<TileData::TypeIndex>(TileData::Type::Max) < tile.tileType ||
+					TileData::gUV_CELL_NUM.x * TileData::gUV_CELL_NUM.y <= tile.uv)
+				{
+					return false;
+				}
+
+				// 詰めた形のまま持つので変換は要らない
+				rTileDesc.x = tile.x;
+				rTileDesc.y = tile.y;
+				rTileDesc.uv = tile.uv;
+				rTileDesc.turn = static_cast<TileData::Turn>(tile.turn);
+				rTileDesc.tileType = tile.tileType;
+			}
+
+			rPieceDesc.aGimmiclDesc.resize(piece.gimmickNum);
+			for (uint32 g = 0; g < piece.gimmickNum; ++g)
+			{
+				const auto& gimmick = pGimmicks[piece.gimmickBegin + g];
+				auto& rGimmickDesc = rPieceDesc.aGimmiclDesc[g];
+
+				if (static_cast<uint8>(TileData::Turn::Max) <= gimmick.turn ||
+					static_cast<GimmickData::TypeIndex>(GimmickData::Type::Max) < gimmick.gimmickType)
+				{
+					return false;
+				}
+
+				rGimmickDesc.x = gimmick.x;
+				rGimmickDesc.y = gimmick.y;
+				rGimmickDesc.turn = static_cast<TileData::Turn>(gimmick.turn);
+				rGimmickDesc.gimmickType = gimmick.gimmickType;
+			}
+
+			rPieceDesc.bakedHash = piece.bakedHash;
+			rPieceDesc.aBakedHitBoxes.reserve(piece.polygonNum);
+			for (uint32 p = 0; p < piece.polygonNum; ++p)
+			{
+				const auto& polygon = pPolygons[piece.polygonBegin + p];
+
+				if (static_cast<uint64>(polygon.vertexBegin) + polygon.vertexNum > header.vertexNum ||
+					static_cast<uint64>(polygon.ringBegin) + polygon.ringNum > header.ringNum)
+				{
+					return false;
+				}
+
+				Array<Array<Vec2>> aHoles(polygon.ringNum);
+				for (uint32 r = 0; r < polygon.ringNum; ++r)
+				{
+					const auto& ring = pRings[polygon.ringBegin + r];
+
+					if (static_cast<uint64>(ring.vertexBegin) + ring.vertexNum > header.vertexNum)
+					{
+						return false;
+					}
+
+					aHoles[r] = ReadVertices(pVertices, ring.vertexBegin, ring.vertexNum);
+				}
+
+				rPieceDesc.aBakedHitBoxes.emplace_back(ReadVertices(pVertices, polygon.vertexBegin, polygon.vertexNum), aHoles);
+			}
+		}
+
+		rDesc = std::move(desc);
+
+		return true;
+	}
+
+	void Encode(const StageData::Desc& desc, std::string& rBuffer)
+	{
+		size_t tileNum = 0;
+		size_t gimmickNum = 0;
+		size_t polygonNum = 0;
+		size_t ringNum = 0;
+		size_t vertexNum = 0;
+
+		for (const auto& pieceDesc : desc.aPieceDescs)
+		{
+			tileNum += pieceDesc.aTileDescs.size();
+			gimmickNum += pieceDesc.aGimmiclDesc.size();
+			polygonNum += pieceDesc.aBakedHitBoxes.size();
+
+			for (const auto& polygon : pieceDesc.aBakedHitBoxes)
+			{
+				ringNum += polygon.inners().size();
+				vertexNum += polygon.outer().size();
+
+				for (const auto& hole : polygon.inners())
+				{
+					vertexNum += hole.size();
+				}
+			}
+		}
+
+		const auto name = desc.stageName.toUTF8();
+
+		Header header{};
+		header.magic = gMAGIC;
+		header.version = gVERSION;
+		header.pieceNum = static_cast<uint32>(desc.aPieceDescs.size());
+		header.tileNum = static_cast<uint32>(tileNum);
+		header.gimmickNum = static_cast<uint32>(gimmickNum);
+		header.nameSize = static_cast<uint32>(name.size());
+		header.polygonNum = static_cast<uint32>(polygonNum);
+		header.ringNum = static_cast<uint32>(ringNum);
+		header.vertexNum = static_cast<uint32>(vertexNum);
+		header.pieceOffset = sizeof(Header);
+		header.tileOffset = header.pieceOffset + header.pieceNum * sizeof(PieceRecord);
+		header.gimmickOffset = header.tileOffset + header.tileNum * sizeof(TileRecord);
+		header.polygonOffset = header.gimmickOffset + header.gimmickNum * sizeof(GimmickRecord);
+		header.ringOffset = header.polygonOffset + header.polygonNum * sizeof(PolygonRecord);
+		header.vertexOffset = header.ringOffset + header.ringNum * sizeof(RingRecord);
+		header.nameOffset = header.vertexOffset + header.vertexNum * sizeof(VertexRecord);
+
+		// 全体の大きさが先に分かるので一度で確保して各レコードを直接書き込む
+		const size_t begin = rBuffer.size();
+		rBuffer.resize(begin + static_cast<size_t>(header.nameOffset) + name.size());
+
+		const auto pBytes = reinterpret_cast<uint8*>(rBuffer.data() + begin);
+		std::memcpy(pBytes, &header, sizeof(Header));
+		std::memcpy(pBytes + header.nameOffset, name.data(), name.size());
+
+		uint32 tileIndex = 0;
+		uint32 gimmickIndex = 0;
+		uint32 polygonIndex = 0;
+		uint32 ringIndex = 0;
+		uint32 vertexIndex = 0;
+
+		for (uint32 i = 0; i < header.pieceNum; ++i)
+		{
+			const auto& pieceDesc = desc.aPieceDescs[i];
+
+			PieceRecord piece{};
+			piece.positionX = pieceDesc.position.x;
+			piece.positionY = pieceDesc.position.y;
+			piece.scale = pieceDesc.scale;
+			piece.angle = pieceDesc.angle;
+			piece.backScaleX = pieceDesc.backScale.x;
+			piece.backScaleY = pieceDesc.backScale.y;
+			piece.tileBegin = tileIndex;
+			piece.tileNum = static_cast<uint32>(pieceDesc.aTileDescs.size());
+			piece.gimmickBegin = gimmickIndex;
+			piece.gimmickNum = static_cast<uint32>(pieceDesc.aGimmiclDesc.size());
+			piece.canMoving = static_cast<uint8>(pieceDesc.canMoving);
+			piece.canScaling = static_cast<uint8>(pieceDesc.canScaling);
+			piece.canRolling = static_cast<uint8>(pieceDesc.canRolling);
+			piece.backType = pieceDesc.backType;
+			piece.polygonBegin = polygonIndex;
+			piece.polygonNum = static_cast<uint32>(pieceDesc.aBakedHitBoxes.size());
+			piece.bakedHash = pieceDesc.bakedHash;
+			std::memcpy(pBytes + header.pieceOffset + i * sizeof(PieceRecord), &piece, sizeof(PieceRecord));
+
+			for (const auto& tileDesc : pieceDesc.aTileDescs)
+			{
+				TileRecord tile{};
+				tile.x = tileDesc.x;
+				tile.y = tileDesc.y;
+				tile.uv = tileDesc.uv;
+				tile.turn = static_cast<uint8>(tileDesc.turn);
+				tile.tileType = tileDesc.tileType;
+				std::memcpy(pBytes + header.tileOffset + tileIndex * sizeof(TileRecord), &tile, sizeof(TileRecord));
+
+				++tileIndex;
+			}
+
+			for (const auto& gimmickDesc : pieceDesc.aGimmiclDesc)
+			{
+				GimmickRecord gimmick{};
+				gimmick.x = gimmickDesc.x;
+				gimmick.y = gimmickDesc.y;
+				gimmick.turn = static_cast<uint8>(gimmickDesc.turn);
+				gimmick.gimmickType = gimmickDesc.gimmickType;
+				std::memcpy(pBytes + header.gimmickOffset + gimmickIndex * sizeof(GimmickRecord), &gimmick, sizeof(GimmickRecord));
+
+				++gimmickIndex;
+			}
+
+			for (const auto& hitBox : pieceDesc.aBakedHitBoxes)
+			{
+				PolygonRecord polygon{};
+				polygon.vertexBegin = vertexIndex;
+				polygon.vertexNum = static_cast<uint32>(hitBox.outer().size());
+				polygon.ringBegin = ringIndex;
+				polygon.ringNum = static_cast<uint32>(hitBox.inners().size());
+				std::memcpy(pBytes + header.polygonOffset + polygonIndex * sizeof(PolygonRecord), &polygon, sizeof(PolygonRecord));
+
+				WriteVertices(hitBox.outer(), pBytes + header.vertexOffset, vertexIndex);
+
+				for (const auto& hole : hitBox.inners())
+				{
+					RingRecord ring{};
+					ring.vertexBegin = vertexIndex;
+					ring.vertexNum = static_cast<uint32>(hole.size());
+					std::memcpy(pBytes + header.ringOffset + ringIndex * sizeof(RingRecord), &ring, sizeof(RingRecord));
+
+					WriteVertices(hole, pBytes + header.vertexOffset, vertexIndex);
+
+					++ringIndex;
+				}
+
+				++polygonIndex;
+			}
+		}
+	}
+
+	bool Write(const StageData::Desc& desc, FilePathView path)
+	{
+		std::string buffer;
+		Encode(desc, buffer);
+
+		BinaryWriter writer{ path };
+
+		if (not writer)
+		{
+			return false;
+		}
+
+		return writer.write(buffer.data(), static_cast<int64>(buffer.size())) == static_cast<int64>(buffer.size());
+	}
+}
@@ -0,0 +1,163 @@
+﻿/** ****************************************************************************************************
+ * @file
+ * @brief 変換済みのステージファイル関連
+ **************************************************************************************************** */
+#pragma once
+
+#include "StageData.h"
+
+/** ****************************************************************************************************
+ * @brief 変換済みのステージファイル関連(ヘッダ、カケラ表、タイル表、ギミック表、当たり判定表、輪郭表、頂点表、ステージ名の順に並ぶ)
+ **************************************************************************************************** */
+namespace MySystem::StageFile
+{
+	static constexpr uint32	gMAGIC = 0x31475453;			//!< ファイルの識別子("STG1")
+	static constexpr uint32	gVERSION = 3;					//!< 形式のバージョン
+	static const String		gEXTENSION = U"stage";			//!< 拡張子
+	static constexpr size_t	gRECORD_ALIGNMENT = 8;			//!< 各表の先頭の揃え
+
+	/** ****************************************************************************************************
+	 * @brief ファイルの先頭
+	 **************************************************************************************************** */
+	struct Header
+	{
+		uint32 magic;			//!< ファイルの識別子
+		uint32 version;			//!< 形式のバージョン
+		uint32 pieceNum;		//!< カケラの数
+		uint32 tileNum;			//!< 全てのカケラのタイルの数
+		uint32 gimmickNum;		//!< 全てのカケラのギミックの数
+		uint32 nameSize;		//!< ステージ名のバイト数(UTF-8)
+		uint32 polygonNum;		//!< 全てのカケラの事前合成した当たり判定の数
+		uint32 ringNum;			//!< 全ての当たり判定の穴の数
+		uint32 vertexNum;		//!< 全ての当たり判定の頂点の数
+		uint32 reserved;		//!< 予約(0)
+		uint64 pieceOffset;		//!< カケラ表の位置
+		uint64 tileOffset;		//!< タイル表の位置
+		uint64 gimmickOffset;	//!< ギミック表の位置
+		uint64 polygonOffset;	//!< 当たり判定表の位置
+		uint64 ringOffset;		//!< 輪郭表の位置
+		uint64 vertexOffset;	//!< 頂点表の位置
+		uint64 nameOffset;		//!< ステージ名の位置
+	};
+
+	/** ****************************************************************************************************
+	 * @brief カケラ1枚分
+	 **************************************************************************************************** */
+	struct PieceRecord
+	{
+		double positionX;		//!< 座標
+		double positionY;		//!< 座標
+		double scale;			//!< 大きさ
+		double angle;			//!< 角度
+		double backScaleX;		//!< 背景の大きさ
+		double backScaleY;		//!< 背景の大きさ
+		uint32 tileBegin;		//!< タイル表での開始位置
+		uint32 tileNum;			//!< タイルの数
+		uint32 gimmickBegin;	//!< ギミック表での開始位置
+		uint32 gimmickNum;		//!< ギミックの数
+		uint8 canMoving;		//!< 移動できるか
+		uint8 canScaling;		//!< 拡大縮小できるか
+		uint8 canRolling;		//!< 回転できるか
+		uint8 backType;			//!< 背景の種類
+		uint8 reserved[4];		//!< 予約(0)
+		uint32 polygonBegin;	//!< 当たり判定表での開始位置
+		uint32 polygonNum;		//!< 事前合成した当たり判定の数
+		uint64 bakedHash;		//!< 事前合成した時のタイルのハッシュ(0 なら事前合成なし)
+	};
+
+	/** ****************************************************************************************************
+	 * @brief タイル1枚分
+	 **************************************************************************************************** */
+	struct TileRecord
+	{
+		int16 x;				//!< 座標(配置の単位)
+		int16 y;				//!< 座標(配置の単位)
+		uint16 uv;				//!< UV開始位置(行 * 列数 + 列)
+		uint8 turn;				//!< 90度単位の回転
+		uint8 tileType;			//!< タイルの種類
+	};
+
+	/** ****************************************************************************************************
+	 * @brief ギミック1つ分
+	 **************************************************************************************************** */
+	struct GimmickRecord
+	{
+		int16 x;				//!< 座標(配置の単位)
+		int16 y;				//!< 座標(配置の単位)
+		uint8 turn;				//!< 90度単位の回転
+		uint8 gimmickType;		//!< ギミックの種類
+		uint8 reserved[2];		//!< 予約(0)
+	};
+
+	/** ****************************************************************************************************
+	 * @brief 事前合成した当たり判定1つ分
+	 **************************************************************************************************** */
+	struct PolygonRecord
+	{
+		uint32 vertexBegin;		//!< 外周の頂点表での開始位置
+		uint32 vertexNum;		//!< 外周の頂点の数
+		uint32 ringBegin;		//!< 穴の輪郭表での開始位置
+		uint32 ringNum;			//!< 穴の数
+	};
+
+	/** ****************************************************************************************************
+	 * @brief 当たり判定の穴1つ分
+	 **************************************************************************************************** */
+	struct RingRecord
+	{
+		uint32 vertexBegin;		//!< 頂点表での開始位置
+		uint32 vertexNum;		//!< 頂点の数
+	};
+
+	/** ****************************************************************************************************
+	 * @brief 頂点1つ分
+	 **************************************************************************************************** */
+	struct VertexRecord
+	{
+		double x;				//!< 座標
+		double y;				//!< 座標
+	};
+
+	static_assert(sizeof(Header) == 96);
+	static_assert(sizeof(PieceRecord) == 88);
+	static_assert(sizeof(TileRecord) == 8);
+	static_assert(sizeof(GimmickRecord) == 8);
+	static_assert(sizeof(PolygonRecord) == 16);
+	static_assert(sizeof(RingRecord) == 8);
+	static_assert(sizeof(VertexRecord) == 16);
+
+	/** ****************************************************************************************************
+	 * @brief				変換済みのステージファイルを読み込む
+	 * @param[in] path		読み込むファイルのパス
+	 * @param[out] rDesc	読み込んだデータ
+	 * @retval true			読み込めた
+	 * @retval false		ファイルが無いか、壊れている
+	 **************************************************************************************************** */
+	bool Read(FilePathView path, StageData::Desc& rDesc);
+
+	/** ****************************************************************************************************
+	 * @brief				メモリ上の変換済みのステージファイルを読み込む
+	 * @param[in] pData		ファイルの中身(8 バイト境界に揃っていること)
+	 * @param[in] size		ファイルのバイト数
+	 * @param[out] rDesc	読み込んだデータ
+	 * @retval true			読み込めた
+	 * @retval false		壊れている
+	 **************************************************************************************************** */
+	bool Decode(const void* pData, const size_t size, StageData::Desc& rDesc);
+
+	/** ****************************************************************************************************
+	 * @brief					変換済みのステージファイルの中身をバッファの末尾に書き込む
+	 * @param[in] desc			書き込むデータ
+	 * @param[out] rBuffer		書き込み先(使い回せるように末尾に追加する)
+	 **************************************************************************************************** */
+	void Encode(const StageData::Desc& desc, std::string& rBuffer);
+
+	/** ****************************************************************************************************
+	 * @brief				変換済みのステージファイルを書き出す
+	 * @param[in] desc		書き出すデータ
+	 * @param[in] path		書き出すファイルのパス
+	 * @retval true			書き出せた
+	 * @retval false		書き出せなかった
+	 **************************************************************************************************** */
+	bool Write(const StageData::Desc& desc, FilePathView path);
+}
@@ -0,0 +1,231 @@
+﻿/** ****************************************************************************************************
+ * @file
+ * @brief ワールド単位でステージをまとめたファイル関連
+ **************************************************************************************************** */
+#include "StagePack.h"
+#include "StageFile.h"
+
+namespace MySystem::StagePack
+{
+	namespace
+	{
+		static constexpr uint32 gMAX_ENTRY_NUM = 256;	//!< 1つのファイルにまとめられるステージの最大数(ステージ番号の範囲)
+
+		/** ****************************************************************************************************
+		 * @brief				ヘッダと索引表を読み込む
+		 * @param[in] reader	読み込むファイル
+		 * @param[out] aRecords	索引表
+		 * @retval true			読み込めた
+		 * @retval false		壊れている
+		 **************************************************************************************************** */
+		bool ReadRecords(BinaryReader& reader, Array<IndexRecord>& aRecords)
+		{
+			const auto fileSize = static_cast<uint64>(reader.size());
+
+			Header header{};
+
+			if (reader.read(&header, sizeof(Header)) != sizeof(Header) ||
+				header.magic != gMAGIC || header.version != gVERSION ||
+				gMAX_ENTRY_NUM < header.entryNum ||
+				fileSize < header.indexOffset ||
+				fileSize - header.indexOffset < static_cast<uint64>(header.entryNum) * sizeof(IndexRecord))
+			{
+				return false;
+			}
+
+			aRecords.resize(header.entryNum);
+
+			const auto indexOffset = static_cast<int64>(header.indexOffset);
+			const auto indexSize = static_cast<int64>(aRecords.size() * sizeof(IndexRecord));
+
+			if (reader.setPos(indexOffset) != indexOffset ||
+				reader.read(aRecords.data(), indexSize) != indexSize)
+			{
+				return false;
+			}
+
+			for (const auto& record : aRecords)
+			{
+				if (fileSize < record.dataOffset || fileSize - record.dataOffset < record.compressedSize ||
+					fileSize < record.nameOffset || fileSize - record.nameOffset < record.nameSize)
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+	}
+
+	bool Write(const Array<Source>& aSources, FilePathView path)
+	{
+		if (gMAX_ENTRY_NUM < aSources.size())
+		{
+			return false;
+		}
+
+		Array<IndexRecord>	aRecords(aSources.size());
+		Array<Blob>			aBodies(aSources.size());
+		std::string			names;
+		std::string			buffer;
+
+		for (size_t i = 0; i < aSources.size(); ++i)
+		{
+			const auto& source = aSources[i];
+			auto& rRecord = aRecords[i];
+
+			buffer.clear();
+			StageFile::Encode(source.desc, buffer);
+
+			aBodies[i] = Zstd::Compress(buffer.data(), buffer.size());
+
+			if (aBodies[i].isEmpty())
+			{
+				return false;
+			}
+
+			const auto name = source.desc.stageName.toUTF8();
+
+			rRecord = IndexRecord{};
+			rRecord.compressedSize = aBodies[i].size();
+			rRecord.rawSize = buffer.size();
+			rRecord.nameOffset = names.size();
+			rRecord.nameSize = static_cast<uint32>(name.size());
+			rRecord.pieceNum = static_cast<uint32>(source.desc.aPieceDescs.size());
+			rRecord.stageIndex = source.stageIndex;
+
+			for (const auto& pieceDesc : source.desc.aPieceDescs)
+			{
+				rRecord.tileNum += static_cast<uint32>(pieceDesc.aTileDescs.size());
+			}
+
+			names += name;
+		}
+
+		Header header{};
+		header.magic = gMAGIC;
+		header.version = gVERSION;
+		header.entryNum = static_cast<uint32>(aRecords.size());
+		header.indexOffset = sizeof(Header);
+
+		// 索引とステージ名を先頭にまとめ、索引だけを読む時に本体を読まずに済むようにする
+		const uint64 nameOffset = header.indexOffset + aRecords.size() * sizeof(IndexRecord);
+		uint64 dataOffset = nameOffset + names.size();
+
+		for (size_t i = 0; i < aRecords.size(); ++i)
+		{
+			aRecords[i].nameOffset += nameOffset;
+			aRecords[i].dataOffset = dataOffset;
+
+			dataOffset += aRecords[i].compressedSize;
+		}
+
+		// 書き出し途中で失敗しても元のファイルが壊れないように、まとめてから置き換える
+		std::string file;
+		file.reserve(static_cast<size_t>(dataOffset));
+
+		file.append(reinterpret_cast<const char*>(&header), sizeof(Header));
+		file.append(reinterpret_cast<const char*>(aRecords.data()), aRecords.size() * sizeof(IndexRecord));
+		file += names;
+
+		for (const auto& body : aBodies)
+		{
+			file.append(reinterpret_cast<const char*>(body.data()), body.size());
+		}
+
+		return StageData::WriteAtomically(path, file);
+	}
+
+	bool ReadIndex(FilePathView path, Array<StageData::Summary>& aSummaries)
+	{
+		BinaryReader reader{ path };
+
+		if (not reader)
+		{
+			return false;
+		}
+
+		Array<IndexRecord> aRecords;
+
+		if (not ReadRecords(reader, aRecords))
+		{
+			return false;
+		}
+
+		aSummaries.clear();
+
+		std::string name;
+
+		for (const auto& record : aRecords)
+		{
+			const auto nameOffset = static_cast<int64>(record.nameOffset);
+			name.resize(record.nameSize);
+
+			if (reader.setPos(nameOffset) != nameOffset ||
+				reader.read(name.data(), record.nameSize) != record.nameSize)
+			{
+				return false;
+			}
+
+			if (aSummaries.size() <= record.stageIndex)
+			{
+				aSummaries.resize(record.stageIndex + 1);
+			}
+
+			auto& rSummary = aSummaries[record.stageIndex];
+			rSummary.stageName = Unicode::FromUTF8(name);
+			rSummary.pieceNum = record.pieceNum;
+			rSummary.tileNum = record.tileNum;
+			rSummary.isExist = true;
+		}
+
+		return true;
+	}
+
+	bool ReadStage(FilePathView path, const StageData::StageIndex stageIndex, StageData::Desc& rDesc)
+	{
+		BinaryReader reader{ path };
+
+		if (not reader)
+		{
+			return false;
+		}
+
+		Array<IndexRecord> aRecords;
+
+		if (not ReadRecords(reader, aRecords))
+		{
+			return false;
+		}
+
+		const auto itr = std::find_if(aRecords.begin(), aRecords.end(),
+			[stageIndex](const IndexRecord& record) { return record.stageIndex == stageIndex; });
+
+		if (itr == aRecords.end())
+		{
+			return false;
+		}
+
+		// 必要なステージの部分だけを読んで展開する
+		Blob compressed;
+		compressed.resize(static_cast<size_t>(itr->compressedSize));
+
+		const auto dataOffset = static_cast<int64>(itr->dataOffset);
+		const auto compressedSize = static_cast<int64>(itr->compressedSize);
+
+		if (reader.setPos(dataOffset) != dataOffset ||
+			reader.read(compressed.data(), compressedSize) != compressedSize)
+		{
+			return false;
+		}
+
+		const Blob raw = Zstd::Decompress(compressed.data(), compressed.size());
+
+		if (raw.size() != itr->rawSize)
+		{
+			return false;
+		}
+
+		return StageFile::Decode(raw.data(), raw.size(), rDesc);
+	}
+}
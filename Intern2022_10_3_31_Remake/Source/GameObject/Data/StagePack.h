@@ -0,0 +1,85 @@
+﻿/** ****************************************************************************************************
+ * @file
+ * @brief ワールド単位でステージをまとめたファイル関連
+ **************************************************************************************************** */
+#pragma once
+
+#include "StageData.h"
+
+/** ****************************************************************************************************
+ * @brief ワールド単位でステージをまとめたファイル関連(ヘッダ、索引表、ステージ名、各ステージの圧縮データの順に並ぶ)
+ **************************************************************************************************** */
+namespace MySystem::StagePack
+{
+	static constexpr uint32	gMAGIC = 0x314B5053;			//!< ファイルの識別子("SPK1")
+	static constexpr uint32	gVERSION = 1;					//!< 形式のバージョン
+	static const String		gEXTENSION = U"stagepack";		//!< 拡張子
+
+	/** ****************************************************************************************************
+	 * @brief ファイルの先頭
+	 **************************************************************************************************** */
+	struct Header
+	{
+		uint32 magic;			//!< ファイルの識別子
+		uint32 version;			//!< 形式のバージョン
+		uint32 entryNum;		//!< ステージの数
+		uint32 reserved;		//!< 予約(0)
+		uint64 indexOffset;		//!< 索引表の位置
+	};
+
+	/** ****************************************************************************************************
+	 * @brief 索引表のステージ1つ分
+	 **************************************************************************************************** */
+	struct IndexRecord
+	{
+		uint64 dataOffset;		//!< 圧縮データの位置
+		uint64 compressedSize;	//!< 圧縮データのバイト数
+		uint64 rawSize;			//!< 展開後(変換済みのステージファイル)のバイト数
+		uint64 nameOffset;		//!< ステージ名の位置
+		uint32 nameSize;		//!< ステージ名のバイト数(UTF-8)
+		uint32 pieceNum;		//!< カケラの数
+		uint32 tileNum;			//!< 全てのカケラのタイルの数
+		uint8 stageIndex;		//!< ステージ番号
+		uint8 reserved[3];		//!< 予約(0)
+	};
+
+	static_assert(sizeof(Header) == 24);
+	static_assert(sizeof(IndexRecord) == 48);
+
+	/** ****************************************************************************************************
+	 * @brief まとめるステージ1つ分
+	 **************************************************************************************************** */
+	struct Source
+	{
+		StageData::StageIndex	stageIndex;		//!< ステージ番号
+		StageData::Desc			desc;			//!< ステージのデータ
+	};
+
+	/** ****************************************************************************************************
+	 * @brief					ステージをまとめて書き出す(ステージごとに変換済みの形式を zstd で圧縮する)
+	 * @param[in] aSources		まとめるステージ群
+	 * @param[in] path			書き出すファイルのパス
+	 * @retval true				書き出せた
+	 * @retval false			書き出せなかった
+	 **************************************************************************************************** */
+	bool Write(const Array<Source>& aSources, FilePathView path);
+
+	/** ****************************************************************************************************
+	 * @brief					索引だけを読み込む(ステージ本体は読まない)
+	 * @param[in] path			読み込むファイルのパス
+	 * @param[out] aSummaries	ステージ番号順のステージの概要(無い番号は isExist が false)
+	 * @retval true				読み込めた
+	 * @retval false			ファイルが無いか、壊れている
+	 **************************************************************************************************** */
+	bool ReadIndex(FilePathView path, Array<StageData::Summary>& aSummaries);
+
+	/** ****************************************************************************************************
+	 * @brief					ステージを1つだけ読み込む(索引から位置を引いてその部分だけ読む)
+	 * @param[in] path			読み込むファイルのパス
+	 * @param[in] stageIndex	読み込むステージ番号
+	 * @param[out] rDesc		読み込んだデータ
+	 * @retval true				読み込めた
+	 * @retval false			ファイルかステージが無いか、壊れている
+	 **************************************************************************************************** */
+	bool ReadStage(FilePathView path, const StageData::StageIndex stageIndex, StageData::Desc& rDesc);
+}
@@ -6,5 +6,25 @@
 
 namespace MySystem::StagePieceData
 {
+	bool IsSameBack(const Desc& a, const Desc& b) noexcept
+	{
+		return a.position == b.position &&
+			a.scale == b.scale &&
+			a.angle == b.angle &&
+			a.backScale == b.backScale &&
+			a.canMoving == b.canMoving &&
+			a.canScaling == b.canScaling &&
+			a.canRolling == b.canRolling &&
+			a.backType == b.backType;
+	}
 
+	bool IsSameTiles(const Desc& a, const Desc& b) noexcept
+	{
+		return a.aTileDescs == b.aTileDescs;
+	}
+
+	bool IsSameGimmicks(const Desc& a, const Desc& b) noexcept
+	{
+		return a.aGimmiclDesc == b.aGimmiclDesc;
+	}
 }
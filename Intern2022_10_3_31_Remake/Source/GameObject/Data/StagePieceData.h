@@ -28,6 +28,7 @@ namespace MySystem::StagePieceData
 	static constexpr uint8	gMAX_PIECE_NUM = 10;	//!< ステージのカケラの最大数
 	static constexpr uint16	gMAX_WIDTH = 40;		//!< タイルが横に並ぶ最大数
 	static constexpr uint16	gMAX_HEIGHT = 24;		//!< タイルが横に並ぶ最大数
+	static constexpr uint16	gMAX_GIMMICK_NUM = gMAX_WIDTH * gMAX_HEIGHT;	//!< 1 枚のカケラに置けるギミックの最大数(1 マスに 1 つまで)
 
 	struct Desc
 	{
@@ -45,6 +46,9 @@ namespace MySystem::StagePieceData
 		Array<TileData::Desc>		aTileDescs;		//!< タイルのデータ群
 		Array<GimmickData::Desc>	aGimmiclDesc;	//!< ギミックのデータ群
 
+		Array<Polygon>	aBakedHitBoxes;	//!< 事前に合成した当たり判定
+		uint64			bakedHash;		//!< 事前に合成した時のタイルのハッシュ(0 なら事前合成なし)
+
 		/** ****************************************************************************************************
 		 * @brief コンストラクタ
 		 **************************************************************************************************** */
@@ -56,10 +60,38 @@ namespace MySystem::StagePieceData
 			canMoving{ false },
 			canScaling{ false },
 			canRolling{ false },
-			backType{ static_cast<TypeIndex>(0) }
+			backType{ static_cast<TypeIndex>(0) },
+			bakedHash{ 0 }
 		{
 
 		}
 	};
+
+	/** ****************************************************************************************************
+	 * @brief				カケラの初期配置、背景、操作可否が同じか確認
+	 * @param[in] a			比べるデータ
+	 * @param[in] b			比べるデータ
+	 * @retval true			同じ
+	 * @retval false		違う
+	 **************************************************************************************************** */
+	bool IsSameBack(const Desc& a, const Desc& b) noexcept;
+
+	/** ****************************************************************************************************
+	 * @brief				カケラのタイルの並びが同じか確認
+	 * @param[in] a			比べるデータ
+	 * @param[in] b			比べるデータ
+	 * @retval true			同じ
+	 * @retval false		違う
+	 **************************************************************************************************** */
+	bool IsSameTiles(const Desc& a, const Desc& b) noexcept;
+
+	/** ****************************************************************************************************
+	 * @brief				カケラのギミックの並びが同じか確認
+	 * @param[in] a			比べるデータ
+	 * @param[in] b			比べるデータ
+	 * @retval true			同じ
+	 * @retval false		違う
+	 **************************************************************************************************** */
+	bool IsSameGimmicks(const Desc& a, const Desc& b) noexcept;
 };
 
@@ -0,0 +1,780 @@
+﻿/** ****************************************************************************************************
+ * @file
+ * @brief CSV 形式のステージ関連
+ **************************************************************************************************** */
+#include "StageText.h"
+
+#include <charconv>
+
+namespace MySystem::StageText
+{
+	namespace
+	{
+		/** ****************************************************************************************************
+		 * @brief テキストを先頭から1度だけ読み進める
+		 **************************************************************************************************** */
+		class Scanner
+		{
+		private:
+			const char*	_pCurrent;		//!< 現在の位置
+			const char*	_pEnd;			//!< 終端
+			const char*	_pLineBegin;	//!< 現在の行の先頭
+			size_t		_line;			//!< 現在の行
+			const char*	_pRowEnd;		//!< 最後に読み終えた行の末尾
+			const char*	_pRowBegin;		//!< 最後に読み終えた行の先頭
+			size_t		_rowLine;		//!< 最後に読み終えた行
+			bool		_hasCell;		//!< 現在の行にまだセルが残っているか
+			Error&		_rError;		//!< 失敗した場所と理由の書き込み先
+
+		public:
+			/** ****************************************************************************************************
+			 * @brief				コンストラクタ
+			 * @param[in] text		読み込むテキスト
+			 * @param[out] rError	失敗した場所と理由の書き込み先
+			 **************************************************************************************************** */
+			Scanner(std::string_view text, Error& rError) noexcept :
+				_pCurrent{ text.data() },
+				_pEnd{ text.data() + text.size() },
+				_pLineBegin{ text.data() },
+				_line{ 1 },
+				_pRowEnd{ text.data() },
+				_pRowBegin{ text.data() },
+				_rowLine{ 1 },
+				_hasCell{ false },
+				_rError{ rError }
+			{
+				// BOM は読み飛ばす
+				if (text.starts_with("\xEF\xBB\xBF"))
+				{
+					_pCurrent += 3;
+					_pLineBegin = _pCurrent;
+				}
+			}
+
+			/** ****************************************************************************************************
+			 * @brief				次の空でない行に進む
+			 * @param[in] name		読み込もうとしている行の名前
+			 * @retval true			進めた
+			 * @retval false		ファイルが終わっていた
+			 **************************************************************************************************** */
+			bool BeginRow(StringView name)
+			{
+				while (_pCurrent != _pEnd)
+				{
+					const char* pLineEnd = _pCurrent;
+
+					while (pLineEnd != _pEnd && (*pLineEnd == ' ' || *pLineEnd == '\t' || *pLineEnd == '\r'))
+					{
+						++pLineEnd;
+					}
+
+					// 空白だけでファイルが終わる場合も行は無いものとする
+					if (pLineEnd == _pEnd)
+					{
+						_pCurrent = _pEnd;
+						break;
+					}
+
+					if (*pLineEnd != '\n')
+					{
+						_hasCell = true;
+						return true;
+					}
+
+					NewLine(pLineEnd + 1);
+				}
+
+				return Fail(_pCurrent, U"{} の行が必要ですがファイルが終わりました"_fmt(name));
+			}
+
+			/** ****************************************************************************************************
+			 * @brief 現在の行の残りを読み飛ばして次の行に進む(余分なセルは無視する)
+			 **************************************************************************************************** */
+			void EndRow() noexcept
+			{
+				while (_hasCell)
+				{
+					std::string_view cell;
+					bool hasEscape = false;
+					ReadCell(cell, hasEscape);
+				}
+			}
+
+			/** ****************************************************************************************************
+			 * @brief				文字列を読み込む
+			 * @param[out] rValue	読み込んだ値
+			 * @param[in] name		読み込もうとしている値の名前
+			 * @retval true			読み込めた
+			 * @retval false		読み込めなかった
+			 **************************************************************************************************** */
+			bool ReadString(String& rValue, StringView name)
+			{
+				std::string_view cell;
+				bool hasEscape = false;
+
+				if (not NextCell(cell, hasEscape, name))
+				{
+					return false;
+				}
+
+				if (not hasEscape)
+				{
+					rValue = Unicode::FromUTF8(cell);
+					return true;
+				}
+
+				// 引用符の中の "" だけは 1 文字に戻す必要がある
+				std::string text;
+				text.reserve(cell.size());
+
+				for (size_t i = 0; i < cell.size(); ++i)
+				{
+					text += cell[i];
+
+					if (cell[i] == '"')
+					{
+						++i;
+					}
+				}
+
+				rValue = Unicode::FromUTF8(text);
+
+				return true;
+			}
+
+			/** ****************************************************************************************************
+			 * @brief				実数を読み込む
+			 * @param[out] rValue	読み込んだ値
+			 * @param[in] name		読み込もうとしている値の名前
+			 * @retval true			読み込めた
+			 * @retval false		読み込めなかった
+			 **************************************************************************************************** */
+			bool ReadDouble(double& rValue, StringView name)
+			{
+				std::string_view cell;
+				bool hasEscape = false;
+
+				if (not NextCell(cell, hasEscape, name))
+				{
+					return false;
+				}
+
+				cell = Trim(cell);
+
+				if (not ParseDouble(cell, rValue))
+				{
+					return Fail(cell.data(), U"{} は実数で書いてください(\"{}\")"_fmt(name, Unicode::FromUTF8(cell)));
+				}
+
+				return true;
+			}
+
+			/** ****************************************************************************************************
+			 * @brief				タイルやギミックの座標を配置の単位で読み込む
+			 * @param[out] rValue	読み込んだ値
+			 * @param[in] name		読み込もうとしている値の名前
+			 * @retval true			読み込めた
+			 * @retval false		読み込めなかった
+			 **************************************************************************************************** */
+			bool ReadGridIndex(TileData::GridIndex& rValue, StringView name)
+			{
+				std::string_view cell;
+				bool hasEscape = false;
+				double value = 0.0;
+
+				if (not NextCell(cell, hasEscape, name))
+				{
+					return false;
+				}
+
+				cell = Trim(cell);
+
+				if (not ParseDouble(cell, value))
+				{
+					return Fail(cell.data(), U"{} は実数で書いてください(\"{}\")"_fmt(name, Unicode::FromUTF8(cell)));
+				}
+
+				if (not TileData::QuantizePosition(value, rValue))
+				{
+					return Fail(cell.data(), U"{} は {} の倍数で書いてください(\"{}\")"_fmt(name, TileData::gGRID_SIZE, Unicode::FromUTF8(cell)));
+				}
+
+				return true;
+			}
+
+			/** ****************************************************************************************************
+			 * @brief				タイルやギミックの角度を90度単位で読み込む
+			 * @param[out] rValue	読み込んだ値
+			 * @param[in] name		読み込もうとしている値の名前
+			 * @retval true			読み込めた
+			 * @retval false		読み込めなかった
+			 **************************************************************************************************** */
+			bool ReadTurn(TileData::Turn& rValue, StringView name)
+			{
+				std::string_view cell;
+				bool hasEscape = false;
+				double value = 0.0;
+
+				if (not NextCell(cell, hasEscape, name))
+				{
+					return false;
+				}
+
+				cell = Trim(cell);
+
+				if (not ParseDouble(cell, value))
+				{
+					return Fail(cell.data(), U"{} は実数で書いてください(\"{}\")"_fmt(name, Unicode::FromUTF8(cell)));
+				}
+
+				if (not TileData::QuantizeAngle(value, rValue))
+				{
+					return Fail(cell.data(), U"{} は 90 度(π/2)単位で書いてください(\"{}\")"_fmt(name, Unicode::FromUTF8(cell)));
+				}
+
+				return true;
+			}
+
+			/** ****************************************************************************************************
+			 * @brief				個数や種類などの 0 以上の整数を読み込む
+			 * @param[out] rValue	読み込んだ値
+			 * @param[in] maxValue	許される最大値
+			 * @param[in] name		読み込もうとしている値の名前
+			 * @retval true			読み込めた
+			 * @retval false		読み込めなかった
+			 **************************************************************************************************** */
+			template<class Type>
+			bool ReadUnsigned(Type& rValue, const uint64 maxValue, StringView name)
+			{
+				std::string_view cell;
+				bool hasEscape = false;
+
+				if (not NextCell(cell, hasEscape, name))
+				{
+					return false;
+				}
+
+				cell = Trim(cell);
+
+				uint64 value = 0;
+				const auto result = std::from_chars(cell.data(), cell.data() + cell.size(), value);
+
+				if (cell.empty() || result.ec != std::errc{} || result.ptr != cell.data() + cell.size())
+				{
+					return Fail(cell.data(), U"{} は 0 以上の整数で書いてください(\"{}\")"_fmt(name, Unicode::FromUTF8(cell)));
+				}
+
+				if (maxValue < value)
+				{
+					return Fail(cell.data(), U"{} が大きすぎます({} > {})"_fmt(name, value, maxValue));
+				}
+
+				rValue = static_cast<Type>(value);
+
+				return true;
+			}
+
+			/** ****************************************************************************************************
+			 * @brief				真偽値を読み込む(true / false / 1 / 0、大文字小文字は問わない)
+			 * @param[out] rValue	読み込んだ値
+			 * @param[in] name		読み込もうとしている値の名前
+			 * @retval true			読み込めた
+			 * @retval false		読み込めなかった
+			 **************************************************************************************************** */
+			bool ReadBool(bool& rValue, StringView name)
+			{
+				std::string_view cell;
+				bool hasEscape = false;
+
+				if (not NextCell(cell, hasEscape, name))
+				{
+					return false;
+				}
+
+				cell = Trim(cell);
+
+				if (EqualsIgnoreCase(cell, "true") || cell == "1")
+				{
+					rValue = true;
+					return true;
+				}
+
+				if (EqualsIgnoreCase(cell, "false") || cell == "0")
+				{
+					rValue = false;
+					return true;
+				}
+
+				return Fail(cell.data(), U"{} は true か false で書いてください(\"{}\")"_fmt(name, Unicode::FromUTF8(cell)));
+			}
+
+			/** ****************************************************************************************************
+			 * @brief				"(x, y)" の形の 2 次元ベクトルを読み込む
+			 * @param[out] rValue	読み込んだ値
+			 * @param[in] name		読み込もうとしている値の名前
+			 * @retval true			読み込めた
+			 * @retval false		読み込めなかった
+			 **************************************************************************************************** */
+			bool ReadVec2(Vec2& rValue, StringView name)
+			{
+				std::string_view cell;
+				bool hasEscape = false;
+
+				if (not NextCell(cell, hasEscape, name))
+				{
+					return false;
+				}
+
+				cell = Trim(cell);
+
+				const size_t separator = cell.find(',');
+
+				if (cell.size() < 2 || cell.front() != '(' || cell.back() != ')' || separator == std::string_view::npos ||
+					not ParseDouble(Trim(cell.substr(1, separator - 1)), rValue.x) ||
+					not ParseDouble(Trim(cell.substr(separator + 1, cell.size() - separator - 2)), rValue.y))
+				{
+					return Fail(cell.data(), U"{} は (x, y) の形で書いてください(\"{}\")"_fmt(name, Unicode::FromUTF8(cell)));
+				}
+
+				return true;
+			}
+
+		private:
+			/** ****************************************************************************************************
+			 * @brief				次の行に進んだことを記録する
+			 * @param[in] pNext		次の行の先頭
+			 **************************************************************************************************** */
+			void NewLine(const char* pNext) noexcept
+			{
+				_pCurrent = pNext;
+				_pLineBegin = pNext;
+				++_line;
+			}
+
+			/** ****************************************************************************************************
+			 * @brief					失敗した場所と理由を記録する
+			 * @param[in] pPosition		失敗した位置
+			 * @param[in] message		理由
+			 * @return					常に false
+			 **************************************************************************************************** */
+			bool Fail(const char* pPosition, const String& message)
+			{
+				// 行の最後のセルは読んだ時点で次の行に進んでいる
+				const bool isPrevRow = (pPosition < _pLineBegin);
+
+				_rError.line = isPrevRow ? _rowLine : _line;
+				_rError.column = static_cast<size_t>(pPosition - (isPrevRow ? _pRowBegin : _pLineBegin)) + 1;
+				_rError.message = message;
+
+				return false;
+			}
+
+			/** ****************************************************************************************************
+			 * @brief					最後に読み終えた行の末尾で失敗したことを記録する
+			 * @param[in] message		理由
+			 * @return					常に false
+			 **************************************************************************************************** */
+			bool FailAtRowEnd(const String& message)
+			{
+				_rError.line = _rowLine;
+				_rError.column = static_cast<size_t>(_pRowEnd - _pRowBegin) + 1;
+				_rError.message = message;
+
+				return false;
+			}
+
+			/** ****************************************************************************************************
+			 * @brief					現在の行から次のセルを取り出す
+			 * @param[out] rCell		セルの中身
+			 * @param[out] rHasEscape	中身に "" が含まれているか
+			 * @param[in] name			読み込もうとしている値の名前
+			 * @retval true				取り出せた
+			 * @retval false			行にセルが残っていなかった
+			 **************************************************************************************************** */
+			bool NextCell(std::string_view& rCell, bool& rHasEscape, StringView name)
+			{
+				if (not _hasCell)
+				{
+					return FailAtRowEnd(U"{} が必要ですが行が終わりました"_fmt(name));
+				}
+
+				ReadCell(rCell, rHasEscape);
+
+				return true;
+			}
+
+			/** ****************************************************************************************************
+			 * @brief					現在の位置からセルを1つ読み進める
+			 * @param[out] rCell		セルの中身(引用符は外す)
+			 * @param[out] rHasEscape	中身に "" が含まれているか
+			 **************************************************************************************************** */
+			void ReadCell(std::string_view& rCell, bool& rHasEscape) noexcept
+			{
+				const char* pBegin = _pCurrent;
+				const char* pEnd = _pCurrent;
+				rHasEscape = false;
+
+				if (_pCurrent != _pEnd && *_pCurrent == '"')
+				{
+					// 引用符の中は区切り文字や改行もそのまま中身とする
+					pBegin = ++_pCurrent;
+
+					while (_pCurrent != _pEnd)
+					{
+						if (*_pCurrent == '"')
+						{
+							if (_pCurrent + 1 != _pEnd && *(_pCurrent + 1) == '"')
+							{
+								rHasEscape = true;
+								_pCurrent += 2;
+								continue;
+							}
+
+							break;
+						}
+
+						if (*_pCurrent == '\n')
+						{
+							++_line;
+							_pLineBegin = _pCurrent + 1;
+						}
+
+						++_pCurrent;
+					}
+
+					pEnd = _pCurrent;
+
+					// 閉じ引用符から区切り文字までは読み捨てる
+					while (_pCurrent != _pEnd && *_pCurrent != ',' && *_pCurrent != '\n')
+					{
+						++_pCurrent;
+					}
+				}
+				else
+				{
+					while (_pCurrent != _pEnd && *_pCurrent != ',' && *_pCurrent != '\n')
+					{
+						++_pCurrent;
+					}
+
+					pEnd = _pCurrent;
+
+					if (pBegin != pEnd && *(pEnd - 1) == '\r')
+					{
+						--pEnd;
+					}
+				}
+
+				rCell = std::string_view{ pBegin, static_cast<size_t>(pEnd - pBegin) };
+
+				if (_pCurrent != _pEnd && *_pCurrent == ',')
+				{
+					++_pCurrent;
+					return;
+				}
+
+				_hasCell = false;
+				_pRowEnd = pEnd;
+				_pRowBegin = _pLineBegin;
+				_rowLine = _line;
+
+				if (_pCurrent != _pEnd)
+				{
+					NewLine(_pCurrent + 1);
+				}
+			}
+
+			/** ****************************************************************************************************
+			 * @brief				前後の空白を取り除く
+			 * @param[in] text		対象の文字列
+			 * @return				取り除いた文字列
+			 **************************************************************************************************** */
+			static std::string_view Trim(std::string_view text) noexcept
+			{
+				while (not text.empty() && (text.front() == ' ' || text.front() == '\t'))
+				{
+					text.remove_prefix(1);
+				}
+
+				while (not text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r'))
+				{
+					text.remove_suffix(1);
+				}
+
+				return text;
+			}
+
+			/** ****************************************************************************************************
+			 * @brief				文字列全体を実数として変換する
+			 * @param[in] text		対象の文字列
+			 * @param[out] rValue	変換した値
+			 * @retval true			変換できた
+			 * @retval false		変換できなかった
+			 **************************************************************************************************** */
+			static bool ParseDouble(std::string_view text, double& rValue) noexcept
+			{
+				// from_chars は先頭の + を受け付けない
+				if (not text.empty() && text.front() == '+')
+				{
+					text.remove_prefix(1);
+				}
+
+				const auto result = std::from_chars(text.data(), text.data() + text.size(), rValue);
+
+				return not text.empty() && result.ec == std::errc{} && result.ptr == text.data() + text.size();
+			}
+
+			/** ****************************************************************************************************
+			 * @brief				英字の大文字小文字を区別せずに比べる
+			 * @param[in] text		対象の文字列
+			 * @param[in] other		比べる文字列(小文字)
+			 * @retval true			等しい
+			 * @retval false		等しくない
+			 **************************************************************************************************** */
+			static bool EqualsIgnoreCase(std::string_view text, std::string_view other) noexcept
+			{
+				if (text.size() != other.size())
+				{
+					return false;
+				}
+
+				for (size_t i = 0; i < text.size(); ++i)
+				{
+					const char c = ('A' <= text[i] && text[i] <= 'Z') ? static_cast<char>(text[i] - 'A' + 'a') : text[i];
+
+					if (c != other[i])
+					{
+						return false;
+					}
+				}
+
+				return true;
+			}
+		};
+
+		/** ****************************************************************************************************
+		 * @brief				数値を文字列にせず直接バッファに書き込む
+		 * @param[in] value		書き込む値
+		 * @param[out] rBuffer	書き込み先
+		 **************************************************************************************************** */
+		template<class Type>
+		void AppendNumber(const Type value, std::string& rBuffer)
+		{
+			char text[32];
+			const auto result = std::to_chars(std::begin(text), std::end(text), value);
+
+			rBuffer.append(text, result.ptr);
+		}
+
+		/** ****************************************************************************************************
+		 * @brief				真偽値を読み込める形でバッファに書き込む
+		 * @param[in] value		書き込む値
+		 * @param[out] rBuffer	書き込み先
+		 **************************************************************************************************** */
+		void AppendBool(const bool value, std::string& rBuffer)
+		{
+			rBuffer += (value ? "true" : "false");
+		}
+	}
+
+	bool Parse(std::string_view text, StageData::Desc& rDesc, Error& rError)
+	{
+		Scanner scanner{ text, rError };
+		StageData::Desc desc;
+
+		if (not (scanner.BeginRow(U"ステージ名") && scanner.ReadString(desc.stageName, U"ステージ名")))
+		{
+			return false;
+		}
+		scanner.EndRow();
+
+		size_t pieceNum = 0;
+		if (not (scanner.BeginRow(U"カケラの数") && scanner.ReadUnsigned(pieceNum, StagePieceData::gMAX_PIECE_NUM, U"カケラの数")))
+		{
+			return false;
+		}
+		scanner.EndRow();
+
+		// 1 枚のカケラに置けるタイルの最大数(三角形を重ねる分の余裕を持たせる)
+		static constexpr uint64 MAX_TILE_NUM = static_cast<uint64>(StagePieceData::gMAX_WIDTH) * StagePieceData::gMAX_HEIGHT * 4;
+
+		desc.aPieceDescs.resize(pieceNum);
+
+		for (auto& rPieceDesc : desc.aPieceDescs)
+		{
+			if (not (scanner.BeginRow(U"カケラ") &&
+				scanner.ReadDouble(rPieceDesc.position.x, U"カケラの X 座標") &&
+				scanner.ReadDouble(rPieceDesc.position.y, U"カケラの Y 座標") &&
+				scanner.ReadDouble(rPieceDesc.scale, U"カケラの大きさ") &&
+				scanner.ReadDouble(rPieceDesc.angle, U"カケラの角度") &&
+				scanner.ReadVec2(rPieceDesc.backScale, U"カケラの背景の大きさ")))
+			{
+				return false;
+			}
+			scanner.EndRow();
+
+			if (not (scanner.BeginRow(U"カケラの操作") &&
+				scanner.ReadBool(rPieceDesc.canMoving, U"移動できるか") &&
+				scanner.ReadBool(rPieceDesc.canScaling, U"拡大縮小できるか") &&
+				scanner.ReadBool(rPieceDesc.canRolling, U"回転できるか") &&
+				scanner.ReadUnsigned(rPieceDesc.backType, static_cast<uint64>(StagePieceData::Type::Max) - 1, U"背景の種類")))
+			{
+				return false;
+			}
+			scanner.EndRow();
+
+			size_t tileNum = 0;
+			if (not (scanner.BeginRow(U"タイルの数") && scanner.ReadUnsigned(tileNum, MAX_TILE_NUM, U"タイルの数")))
+			{
+				return false;
+			}
+			scanner.EndRow();
+
+			rPieceDesc.aTileDescs.resize(tileNum);
+			for (auto& rTileDesc : rPieceDesc.aTileDescs)
+			{
+				Point uv{ 0, 0 };
+
+				if (not (scanner.BeginRow(U"タイル") &&
+					scanner.ReadGridIndex(rTileDesc.x, U"タイルの X 座標") &&
+					scanner.ReadGridIndex(rTileDesc.y, U"タイルの Y 座標") &&
+					scanner.ReadTurn(rTileDesc.turn, U"タイルの角度") &&
+					scanner.ReadUnsigned(rTileDesc.tileType, static_cast<uint64>(TileData::Type::Max), U"タイルの種類") &&
+					scanner.ReadUnsigned(uv.x, static_cast<uint64>(TileData::gUV_CELL_NUM.x - 1), U"タイルの UV の X") &&
+					scanner.ReadUnsigned(uv.y, static_cast<uint64>(TileData::gUV_CELL_NUM.y - 1), U"タイルの UV の Y")))
+				{
+					return false;
+				}
+				scanner.EndRow();
+
+				rTileDesc.SetUV(uv);
+			}
+
+			size_t gimmickNum = 0;
+			if (not (scanner.BeginRow(U"ギミックの数") && scanner.ReadUnsigned(gimmickNum, StagePieceData::gMAX_GIMMICK_NUM, U"ギミックの数")))
+			{
+				return false;
+			}
+			scanner.EndRow();
+
+			rPieceDesc.aGimmiclDesc.resize(gimmickNum);
+			for (auto& rGimmickDesc : rPieceDesc.aGimmiclDesc)
+			{
+				if (not (scanner.BeginRow(U"ギミック") &&
+					scanner.ReadGridIndex(rGimmickDesc.x, U"ギミックの X 座標") &&
+					scanner.ReadGridIndex(rGimmickDesc.y, U"ギミックの Y 座標") &&
+					scanner.ReadTurn(rGimmickDesc.turn, U"ギミックの角度") &&
+					scanner.ReadUnsigned(rGimmickDesc.gimmickType, static_cast<uint64>(GimmickData::Type::Max), U"ギミックの種類")))
+				{
+					return false;
+				}
+				scanner.EndRow();
+			}
+		}
+
+		rDesc = std::move(desc);
+
+		return true;
+	}
+
+	bool Read(FilePathView path, StageData::Desc& rDesc, Error& rError)
+	{
+		rError = Error{};
+		rError.path = path;
+
+		MemoryMappedFileView file{ path };
+
+		if (not file)
+		{
+			rError.message = U"ファイルを開けませんでした";
+			return false;
+		}
+
+		const auto memory = file.map();
+		const std::string_view text{ reinterpret_cast<const char*>(memory.data), (memory.data == nullptr) ? 0 : memory.size };
+
+		return Parse(text, rDesc, rError);
+	}
+
+	void Encode(const StageData::Desc& desc, std::string& rBuffer)
+	{
+		// ステージ名だけは区切り文字を含み得るので常に引用符で囲む
+		rBuffer += '"';
+		for (const char c : desc.stageName.toUTF8())
+		{
+			if (c == '"')
+			{
+				rBuffer += '"';
+			}
+			rBuffer += c;
+		}
+		rBuffer += "\"\n";
+
+		AppendNumber(desc.aPieceDescs.size(), rBuffer);
+		rBuffer += '\n';
+
+		for (const auto& pieceDesc : desc.aPieceDescs)
+		{
+			AppendNumber(pieceDesc.position.x, rBuffer);
+			rBuffer += ',';
+			AppendNumber(pieceDesc.position.y, rBuffer);
+			rBuffer += ',';
+			AppendNumber(pieceDesc.scale, rBuffer);
+			rBuffer += ',';
+			AppendNumber(pieceDesc.angle, rBuffer);
+			rBuffer += ",\"(";
+			AppendNumber(pieceDesc.backScale.x, rBuffer);
+			rBuffer += ", ";
+			AppendNumber(pieceDesc.backScale.y, rBuffer);
+			rBuffer += ")\"\n";
+
+			AppendBool(pieceDesc.canMoving, rBuffer);
+			rBuffer += ',';
+			AppendBool(pieceDesc.canScaling, rBuffer);
+			rBuffer += ',';
+			AppendBool(pieceDesc.canRolling, rBuffer);
+			rBuffer += ',';
+			AppendNumber(static_cast<int32>(pieceDesc.backType), rBuffer);
+			rBuffer += '\n';
+
+			AppendNumber(pieceDesc.aTileDescs.size(), rBuffer);
+			rBuffer += '\n';
+
+			for (const auto& tileDesc : pieceDesc.aTileDescs)
+			{
+				const auto position = tileDesc.GetPosition();
+				const auto uv = tileDesc.GetUV();
+
+				AppendNumber(position.x, rBuffer);
+				rBuffer += ',';
+				AppendNumber(position.y, rBuffer);
+				rBuffer += ',';
+				AppendNumber(tileDesc.GetAngle(), rBuffer);
+				rBuffer += ',';
+				AppendNumber(static_cast<int32>(tileDesc.tileType), rBuffer);
+				rBuffer += ',';
+				AppendNumber(uv.x, rBuffer);
+				rBuffer += ',';
+				AppendNumber(uv.y, rBuffer);
+				rBuffer += '\n';
+			}
+
+			AppendNumber(pieceDesc.aGimmiclDesc.size(), rBuffer);
+			rBuffer += '\n';
+
+			for (const auto& gimmickDesc : pieceDesc.aGimmiclDesc)
+			{
+				const auto position = gimmickDesc.GetPosition();
+
+				AppendNumber(position.x, rBuffer);
+				rBuffer += ',';
+				AppendNumber(position.y, rBuffer);
+				rBuffer += ',';
+				AppendNumber(gimmickDesc.GetAngle(), rBuffer);
+				rBuffer += ',';
+				AppendNumber(static_cast<int32>(gimmickDesc.gimmickType), rBuffer);
+				rBuffer += '\n';
+			}
+		}
+	}
+}
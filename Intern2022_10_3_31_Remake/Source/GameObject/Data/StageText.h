@@ -0,0 +1,74 @@
+﻿/** ****************************************************************************************************
+ * @file
+ * @brief CSV 形式のステージ関連
+ **************************************************************************************************** */
+#pragma once
+
+#include "StageData.h"
+
+/** ****************************************************************************************************
+ * @brief CSV 形式のステージ関連(ステージ名、カケラの数、カケラごとの行の順に並ぶ)
+ **************************************************************************************************** */
+namespace MySystem::StageText
+{
+	static const String gEXTENSION = U"csv";	//!< 拡張子
+
+	/** ****************************************************************************************************
+	 * @brief 読み込みに失敗した場所と理由
+	 **************************************************************************************************** */
+	struct Error
+	{
+		FilePath	path;		//!< ファイルのパス
+		size_t		line;		//!< 行(1 から)
+		size_t		column;		//!< 列(1 から、UTF-8 のバイト単位)
+		String		message;	//!< 理由
+
+		/** ****************************************************************************************************
+		 * @brief コンストラクタ
+		 **************************************************************************************************** */
+		inline Error() noexcept :
+			path{},
+			line{ 0 },
+			column{ 0 },
+			message{}
+		{
+
+		}
+
+		/** ****************************************************************************************************
+		 * @brief	「パス(行,列): 理由」の形の文字列に変換
+		 * @return	変換した文字列
+		 **************************************************************************************************** */
+		inline String ToString() const
+		{
+			return U"{}({},{}): {}"_fmt(path, line, column, message);
+		}
+	};
+
+	/** ****************************************************************************************************
+	 * @brief				UTF-8 のテキストを1度だけ走査してステージを読み込む
+	 * @param[in] text		読み込むテキスト
+	 * @param[out] rDesc	読み込んだデータ
+	 * @param[out] rError	読み込めなかった場所と理由(path は設定しない)
+	 * @retval true			読み込めた
+	 * @retval false		読み込めなかった
+	 **************************************************************************************************** */
+	bool Parse(std::string_view text, StageData::Desc& rDesc, Error& rError);
+
+	/** ****************************************************************************************************
+	 * @brief				CSV 形式のステージファイルを読み込む
+	 * @param[in] path		読み込むファイルのパス
+	 * @param[out] rDesc	読み込んだデータ
+	 * @param[out] rError	読み込めなかった場所と理由
+	 * @retval true			読み込めた
+	 * @retval false		読み込めなかった
+	 **************************************************************************************************** */
+	bool Read(FilePathView path, StageData::Desc& rDesc, Error& rError);
+
+	/** ****************************************************************************************************
+	 * @brief				CSV 形式のステージをバッファの末尾に書き込む
+	 * @param[in] desc		書き込むデータ
+	 * @param[out] rBuffer	書き込み先(使い回せるように末尾に追加する)
+	 **************************************************************************************************** */
+	void Encode(const StageData::Desc& desc, std::string& rBuffer);
+}
@@ -3,9 +3,627 @@
  * @brief タイルのデータ操作関連
  **************************************************************************************************** */
 #include "TileData.h"
+#include <map>
+#include <numeric>
+#include <set>
 
 namespace MySystem::TileData
 {
+	namespace
+	{
+		static constexpr int32	gQUARTER_NUM = 4;		//!< 1マスを対角線で分けた三角形の数(上・右・下・左の順)
+		static constexpr double	gGRID_EPSILON = 0.001;	//!< 格子に乗っているとみなす誤差
+		static constexpr int32	gMAX_UNION_PASS = 8;	//!< 丸めた交点で新しくできた交差を分割し直す最大回数
+
+		//! 各三角形の外側の辺の始点(マスの左上・右上・右下・左下)
+		static constexpr std::array<Point, gQUARTER_NUM> gQUARTER_CORNERS = {
+			Point{ 0, 0 }, Point{ 1, 0 }, Point{ 1, 1 }, Point{ 0, 1 }
+		};
+
+		//! 各三角形の外側の辺を挟んだ隣のマス
+		static constexpr std::array<Point, gQUARTER_NUM> gQUARTER_NEIGHBORS = {
+			Point{ 0, -1 }, Point{ 1, 0 }, Point{ 0, 1 }, Point{ -1, 0 }
+		};
+
+		//! 各三角形の重心(マス内の座標)
+		static constexpr std::array<Vec2, gQUARTER_NUM> gQUARTER_CENTERS = {
+			Vec2{ 0.5, 1.0 / 6.0 }, Vec2{ 5.0 / 6.0, 0.5 }, Vec2{ 0.5, 5.0 / 6.0 }, Vec2{ 1.0 / 6.0, 0.5 }
+		};
+
+		//! 左上を中心に90度ずつ回転させたタイルが占めるマスの左上
+		static constexpr std::array<Point, gQUARTER_NUM> gTURN_CELL_OFFSETS = {
+			Point{ 0, 0 }, Point{ -1, 0 }, Point{ -1, -1 }, Point{ 0, -1 }
+		};
+
+		/** ****************************************************************************************************
+		 * @brief 頂点番号で表した向きのある辺
+		 **************************************************************************************************** */
+		struct Edge
+		{
+			uint32 from;	//!< 始点
+			uint32 to;		//!< 終点
+		};
+
+		/** ****************************************************************************************************
+		 * @brief				座標を90度ずつ回転させる
+		 * @param[in] position	対象の座標
+		 * @param[in] turn		回転数
+		 * @return				回転後の座標
+		 **************************************************************************************************** */
+		Vec2 RotateQuarter(Vec2 position, int32 turn)
+		{
+			for (int32 i = 0; i < turn; ++i)
+			{
+				position = Vec2{ -position.y, position.x };
+			}
+
+			return position;
+		}
+
+		/** ****************************************************************************************************
+		 * @brief				辺をつなげて閉じた頂点列にする
+		 * @param[in] vertexNum	頂点の数
+		 * @param[in] aEdges	辺群(各頂点で入る辺と出る辺の数が等しいこと)
+		 * @return				頂点番号の列群
+		 **************************************************************************************************** */
+		Array<Array<uint32>> ChainLoops(size_t vertexNum, const Array<Edge>& aEdges)
+		{
+			// 始点ごとに終点を並べる
+			Array<uint32> aStarts(vertexNum + 1, 0);
+
+			for (const auto& edge : aEdges)
+			{
+				++aStarts[edge.from + 1];
+			}
+
+			for (size_t i = 1; i <= vertexNum; ++i)
+			{
+				aStarts[i] += aStarts[i - 1];
+			}
+
+			Array<uint32> aCursors{ aStarts };
+			Array<uint32> aDestinations(aEdges.size());
+
+			for (const auto& edge : aEdges)
+			{
+				aDestinations[aCursors[edge.from]++] = edge.to;
+			}
+
+			aCursors = aStarts;
+
+			Array<Array<uint32>> aLoops;
+			Array<uint32> aPath;
+			Array<int32> aPathPositions(vertexNum, -1);
+
+			for (uint32 start = 0; start < vertexNum; ++start)
+			{
+				while (aCursors[start] < aStarts[start + 1])
+				{
+					aPath.clear();
+					aPath << start;
+					aPathPositions[start] = 0;
+
+					uint32 current = start;
+					while (aCursors[current] < aStarts[current + 1])
+					{
+						const uint32 next = aDestinations[aCursors[current]++];
+
+						if (aPathPositions[next] < 0)
+						{
+							aPathPositions[next] = static_cast<int32>(aPath.size());
+							aPath << next;
+							current = next;
+							continue;
+						}
+
+						// 同じ頂点に戻ってきたら、そこまでを1つの輪として切り出す(角で接する輪も分かれる)
+						const size_t begin = static_cast<size_t>(aPathPositions[next]);
+						aLoops.emplace_back(aPath.begin() + begin, aPath.end());
+
+						for (size_t i = begin + 1; i < aPath.size(); ++i)
+						{
+							aPathPositions[aPath[i]] = -1;
+						}
+
+						aPath.resize(begin + 1);
+						current = next;
+					}
+
+					for (auto vertex : aPath)
+					{
+						aPathPositions[vertex] = -1;
+					}
+				}
+			}
+
+			return aLoops;
+		}
+
+		/** ****************************************************************************************************
+		 * @brief			頂点列の符号付き面積を求める
+		 * @param[in] loop	頂点列
+		 * @return			画面上で時計回りなら正、反時計回りなら負
+		 **************************************************************************************************** */
+		double CalcuSignedArea(const Array<Vec2>& loop)
+		{
+			double area = 0.0;
+
+			for (size_t i = 0, max = loop.size(); i < max; ++i)
+			{
+				area += loop[i].cross(loop[(i + 1) % max]);
+			}
+
+			return area * 0.5;
+		}
+
+		/** ****************************************************************************************************
+		 * @brief			点が頂点列の内側にあるか
+		 * @param[in] loop	頂点列
+		 * @param[in] point	点
+		 * @retval true		内側にある
+		 * @retval false	外側にある
+		 **************************************************************************************************** */
+		bool IsInsideLoop(const Array<Vec2>& loop, const Vec2& point)
+		{
+			bool isInside = false;
+
+			for (size_t i = 0, max = loop.size(), j = max - 1; i < max; j = i++)
+			{
+				const auto& a = loop[i];
+				const auto& b = loop[j];
+
+				if ((a.y > point.y) != (b.y > point.y) &&
+					point.x < (b.x - a.x) * (point.y - a.y) / (b.y - a.y) + a.x)
+				{
+					isInside = not isInside;
+				}
+			}
+
+			return isInside;
+		}
+
+		/** ****************************************************************************************************
+		 * @brief				閉じた頂点列群を外周と穴に分けてポリゴンにする
+		 * @param[in] aLoops	頂点列群(右側が内側になる向き)
+		 * @return				ポリゴン群
+		 **************************************************************************************************** */
+		Array<Polygon> CreatePolygonsFromLoops(const Array<Array<Vec2>>& aLoops)
+		{
+			Array<size_t> aOuterIndices;
+			Array<double> aOuterAreas;
+			Array<size_t> aHoleIndices;
+
+			for (size_t i = 0, max = aLoops.size(); i < max; ++i)
+			{
+				if (aLoops[i].size() < 3)
+				{
+					continue;
+				}
+
+				const auto area = CalcuSignedArea(aLoops[i]);
+
+				if (area > 0.0)
+				{
+					aOuterIndices << i;
+					aOuterAreas << area;
+				}
+				else if (area < 0.0)
+				{
+					aHoleIndices << i;
+				}
+			}
+
+			Array<Array<Array<Vec2>>> aHoles(aOuterIndices.size());
+
+			for (auto holeIndex : aHoleIndices)
+			{
+				const auto& hole = aLoops[holeIndex];
+
+				// 穴の辺のすぐ右側は塗られている側なので、そこを含む一番小さい外周に属する
+				const auto vector = hole[1] - hole[0];
+				const auto point = (hole[0] + hole[1]) * 0.5 + Vec2{ -vector.y, vector.x } * 0.01;
+
+				Optional<size_t> owner;
+				for (size_t i = 0, max = aOuterIndices.size(); i < max; ++i)
+				{
+					if (owner && aOuterAreas[*owner] <= aOuterAreas[i])
+					{
+						continue;
+					}
+
+					if (IsInsideLoop(aLoops[aOuterIndices[i]], point))
+					{
+						owner = i;
+					}
+				}
+
+				if (owner)
+				{
+					aHoles[*owner] << hole;
+				}
+			}
+
+			Array<Polygon> results;
+			results.reserve(aOuterIndices.size());
+
+			for (size_t i = 0, max = aOuterIndices.size(); i < max; ++i)
+			{
+				results.emplace_back(aLoops[aOuterIndices[i]], aHoles[i]);
+			}
+
+			return results;
+		}
+
+		/** ****************************************************************************************************
+		 * @brief 合成前の向きのある辺(座標は合成の細かさを 1 とした整数)
+		 **************************************************************************************************** */
+		struct UnionSegment
+		{
+			Vec2		begin;		//!< 始点
+			Vec2		end;		//!< 終点
+			Array<Vec2>	aSplits;	//!< 途中で分割する点
+		};
+
+		/** ****************************************************************************************************
+		 * @brief				合成に使う格子に丸める(入力の頂点も交点も同じ格子に乗せる)
+		 * @param[in] position	合成の細かさを 1 とした座標
+		 * @return				丸めた座標
+		 **************************************************************************************************** */
+		Vec2 SnapToUnionGrid(const Vec2& position)
+		{
+			return Vec2{ Round(position.x), Round(position.y) };
+		}
+
+		/** ****************************************************************************************************
+		 * @brief		x、y の順で比べる(走査の進む順)
+		 * @param[in] a	比べる点
+		 * @param[in] b	比べる点
+		 * @retval true	a の方が先
+		 * @retval false	b の方が先か同じ
+		 **************************************************************************************************** */
+		bool IsSweepBefore(const Vec2& a, const Vec2& b)
+		{
+			return a.x < b.x || (a.x == b.x && a.y < b.y);
+		}
+
+		/** ****************************************************************************************************
+		 * @brief				辺の途中にある点を分割点として登録する
+		 * @param[out] rSegment	対象の辺
+		 * @param[in] point		分割する点
+		 * @retval true			登録した
+		 * @retval false		端点か辺の外なので登録しなかった
+		 **************************************************************************************************** */
+		bool AddSplitIfInside(UnionSegment& rSegment, const Vec2& point)
+		{
+			const auto vector = rSegment.end - rSegment.begin;
+			const auto t = (point - rSegment.begin).dot(vector);
+
+			if (t <= 0.0 || vector.lengthSq() <= t)
+			{
+				return false;
+			}
+
+			rSegment.aSplits << point;
+			return true;
+		}
+
+		/** ****************************************************************************************************
+		 * @brief				交差している点と他の辺の端点が乗っている点を、各辺の分割点として登録する
+		 * @param[out] aSegments	対象の辺群
+		 * @retval true			分割点を登録した
+		 * @retval false		交差も重なりも無かった
+		 **************************************************************************************************** */
+		bool FindSplits(Array<UnionSegment>& aSegments)
+		{
+			/** ****************************************************************************************************
+			 * @brief 走査で止まる点
+			 **************************************************************************************************** */
+			struct SweepEvent
+			{
+				Array<uint32>	aStarts;	//!< ここから始まる辺
+				Array<uint32>	aEnds;		//!< ここで終わる辺
+				Array<uint32>	aCrosses;	//!< ここで交差すると分かった辺
+			};
+
+			static constexpr uint32 PROBE = std::numeric_limits<uint32>::max();
+			static constexpr double THROUGH_EPSILON = 1.0e-6;	// 点を通るとみなす誤差(格子の間隔に対する割合)
+
+			const size_t segmentNum = aSegments.size();
+
+			// 走査の進む順に左端・右端をそろえる
+			Array<Vec2> aLefts(segmentNum);
+			Array<Vec2> aRights(segmentNum);
+			std::map<std::pair<double, double>, SweepEvent> events;
+
+			for (size_t i = 0; i < segmentNum; ++i)
+			{
+				aLefts[i] = aSegments[i].begin;
+				aRights[i] = aSegments[i].end;
+
+				if (IsSweepBefore(aRights[i], aLefts[i]))
+				{
+					std::swap(aLefts[i], aRights[i]);
+				}
+
+				events[{ aLefts[i].x, aLefts[i].y }].aStarts << static_cast<uint32>(i);
+				events[{ aRights[i].x, aRights[i].y }].aEnds << static_cast<uint32>(i);
+			}
+
+			Vec2 eventPoint{ 0.0, 0.0 };
+			uint32 stamp = 0;
+			Array<uint32> aStamps(segmentNum, 0);	// 今の点を通る辺の印(その辺の位置は今の点の y とする)
+
+			auto getSegmentY = [&aLefts, &aRights, &eventPoint](uint32 index)
+			{
+				const auto& left = aLefts[index];
+				const auto& right = aRights[index];
+
+				if (left.x == right.x)
+				{
+					return Clamp(eventPoint.y, left.y, right.y);
+				}
+
+				if (eventPoint.x <= left.x)
+				{
+					return left.y;
+				}
+
+				if (right.x <= eventPoint.x)
+				{
+					return right.y;
+				}
+
+				return left.y + (right.y - left.y) * (eventPoint.x - left.x) / (right.x - left.x);
+			};
+
+			auto getY = [&aStamps, &stamp, &eventPoint, &getSegmentY](uint32 index)
+			{
+				if (index == PROBE || aStamps[index] == stamp)
+				{
+					return eventPoint.y;
+				}
+
+				return getSegmentY(index);
+			};
+
+			auto compare = [&aLefts, &aRights, &eventPoint, &getY](uint32 a, uint32 b)
+			{
+				if (a == PROBE || b == PROBE)
+				{
+					return getY(a) < getY(b);
+				}
+
+				const auto aVector = aRights[a] - aLefts[a];
+				const auto bVector = aRights[b] - aLefts[b];
+				const double cross = aVector.cross(bVector);
+
+				// 同じ直線上の辺は位置の誤差で前後しないように番号順にする
+				if (cross == 0.0 && aVector.cross(aLefts[b] - aLefts[a]) == 0.0)
+				{
+					return a < b;
+				}
+
+				const double aY = getY(a);
+				const double bY = getY(b);
+
+				if (Abs(aY - bY) > THROUGH_EPSILON)
+				{
+					return aY < bY;
+				}
+
+				// 同じ点を通る辺は、今の点以前なら交わった後(すぐ右)、今の点より後ならまだ交わる前(すぐ左)の順にする
+				if (cross != 0.0)
+				{
+					return (aY > eventPoint.y + THROUGH_EPSILON) ? (cross < 0.0) : (cross > 0.0);
+				}
+
+				return a < b;
+			};
+
+			using Status = std::set<uint32, decltype(compare)>;
+
+			Status status{ compare };
+			Array<Status::iterator> aItrs(segmentNum, status.end());
+
+			// 隣り合った辺が今の点より後で交わるなら、その点で止まるようにする
+			auto addCrossEvent = [&aLefts, &aRights, &eventPoint, &events](uint32 a, uint32 b)
+			{
+				const auto r = aRights[a] - aLefts[a];
+				const auto s = aRights[b] - aLefts[b];
+				const double denominator = r.cross(s);
+
+				// 平行な辺の重なりは端点で止まった時に見つかる
+				if (denominator == 0.0)
+				{
+					return;
+				}
+
+				const auto diff = aLefts[b] - aLefts[a];
+				const double t = diff.cross(s) / denominator;
+				const double u = diff.cross(r) / denominator;
+
+				if (t < 0.0 || 1.0 < t || u < 0.0 || 1.0 < u)
+				{
+					return;
+				}
+
+				// 端点で接しているなら、端点の正確な座標で止まる
+				Vec2 point = aLefts[a] + r * t;
+
+				if (u == 0.0)
+				{
+					point = aLefts[b];
+				}
+				else if (u == 1.0)
+				{
+					point = aRights[b];
+				}
+				else if (t == 0.0)
+				{
+					point = aLefts[a];
+				}
+				else if (t == 1.0)
+				{
+					point = aRights[a];
+				}
+
+				if (not IsSweepBefore(eventPoint, point))
+				{
+					return;
+				}
+
+				events[{ point.x, point.y }].aCrosses << a << b;
+			};
+
+			Array<uint32> aThroughs;
+			bool isSplit = false;
+
+			while (not events.empty())
+			{
+				const auto node = events.extract(events.begin());
+				const auto& event = node.mapped();
+
+				eventPoint = Vec2{ node.key().first, node.key().second };
+				++stamp;
+				aThroughs.clear();
+
+				auto markThrough = [&aStamps, &stamp, &aThroughs](uint32 index)
+				{
+					if (aStamps[index] != stamp)
+					{
+						aStamps[index] = stamp;
+						aThroughs << index;
+					}
+				};
+
+				for (auto index : event.aEnds)
+				{
+					markThrough(index);
+				}
+
+				for (auto index : event.aCrosses)
+				{
+					if (aItrs[index] != status.end())
+					{
+						markThrough(index);
+					}
+				}
+
+				// 今の点を通る辺は並びの中で連続しているので、前後へたどって全て集める
+				const auto center = status.lower_bound(PROBE);
+
+				for (auto itr = center; itr != status.end(); ++itr)
+				{
+					if (aStamps[*itr] != stamp && THROUGH_EPSILON < Abs(getSegmentY(*itr) - eventPoint.y))
+					{
+						break;
+					}
+
+					markThrough(*itr);
+				}
+
+				for (auto itr = center; itr != status.begin(); )
+				{
+					--itr;
+
+					if (aStamps[*itr] != stamp && THROUGH_EPSILON < Abs(getSegmentY(*itr) - eventPoint.y))
+					{
+						break;
+					}
+
+					markThrough(*itr);
+				}
+
+				// 途中を通る辺は丸めた点で分割し、通る辺は全て外してから、続く辺を今の点のすぐ右の順で入れ直す
+				const auto snapPoint = SnapToUnionGrid(eventPoint);
+
+				for (auto index : aThroughs)
+				{
+					status.erase(aItrs[index]);
+					aItrs[index] = status.end();
+
+					if (aLefts[index] != eventPoint && aRights[index] != eventPoint)
+					{
+						isSplit |= AddSplitIfInside(aSegments[index], snapPoint);
+					}
+				}
+
+				for (auto index : event.aStarts)
+				{
+					markThrough(index);
+				}
+
+				for (auto index : aThroughs)
+				{
+					if (aRights[index] != eventPoint)
+					{
+						aItrs[index] = status.insert(index).first;
+					}
+				}
+
+				const auto lower = status.lower_bound(PROBE);
+				const auto upper = status.upper_bound(PROBE);
+
+				if (lower == upper)
+				{
+					if (lower != status.begin() && upper != status.end())
+					{
+						addCrossEvent(*std::prev(lower), *upper);
+					}
+
+					continue;
+				}
+
+				if (lower != status.begin())
+				{
+					addCrossEvent(*std::prev(lower), *lower);
+				}
+
+				if (upper != status.end())
+				{
+					addCrossEvent(*std::prev(upper), *upper);
+				}
+			}
+
+			return isSplit;
+		}
+
+		/** ****************************************************************************************************
+		 * @brief					登録した分割点で辺を分ける
+		 * @param[in,out] aSegments	対象の辺群(分割点は空になる)
+		 **************************************************************************************************** */
+		void SplitSegments(Array<UnionSegment>& aSegments)
+		{
+			Array<UnionSegment> aResults;
+			aResults.reserve(aSegments.size());
+
+			for (auto& segment : aSegments)
+			{
+				const auto vector = segment.end - segment.begin;
+
+				segment.aSplits << segment.begin << segment.end;
+				std::sort(segment.aSplits.begin(), segment.aSplits.end(), [&segment, &vector](const Vec2& a, const Vec2& b)
+					{
+						return (a - segment.begin).dot(vector) < (b - segment.begin).dot(vector);
+					});
+
+				for (size_t i = 0; i + 1 < segment.aSplits.size(); ++i)
+				{
+					if (segment.aSplits[i] == segment.aSplits[i + 1])
+					{
+						continue;
+					}
+
+					auto& result = aResults.emplace_back();
+					result.begin = segment.aSplits[i];
+					result.end = segment.aSplits[i + 1];
+				}
+			}
+
+			aSegments = std::move(aResults);
+		}
+	}
+
 	void GetSimplePolygon(Array<Polygon>& targets, double nearPointDistance, double nearLineDistance)
 	{
 		for (auto itr = targets.begin(); itr != targets.end(); ++itr)
@@ -96,4 +714,635 @@ namespace MySystem::TileData
 
 		return targets;
 	}
+
+	Array<Polygon> CreateGridHitBoxes(const Array<Desc>& aTileDescs, Array<size_t>& aOffGridIndices)
+	{
+		/** ****************************************************************************************************
+		 * @brief 格子に乗っているタイル
+		 **************************************************************************************************** */
+		struct GridTile
+		{
+			size_t		index;		//!< 元のタイルの番号
+			Point		position;	//!< 格子上の座標
+			Point		cell;		//!< 占めるマス
+			int32		turn;		//!< 90度単位の回転数
+			TypeIndex	tileType;	//!< タイルの種類
+		};
+
+		aOffGridIndices.clear();
+
+		Array<GridTile> aGridTiles;
+		aGridTiles.reserve(aTileDescs.size());
+
+		Optional<Vec2> origin;
+		Point minCell{ 0, 0 };
+		Point maxCell{ 0, 0 };
+
+		for (size_t i = 0, max = aTileDescs.size(); i < max; ++i)
+		{
+			const auto& desc = aTileDescs[i];
+
+			// 最初に見つかったタイルを格子の基準にする(半マスずれているものは格子に乗らない)
+			if (not origin)
+			{
+				origin = desc.GetPosition();
+			}
+
+			const Vec2 position = (desc.GetPosition() - *origin) / gTILE_SIZE;
+			const Vec2 roundPosition{ Round(position.x), Round(position.y) };
+			if (Abs(position.x - roundPosition.x) > gGRID_EPSILON ||
+				Abs(position.y - roundPosition.y) > gGRID_EPSILON ||
+				Abs(roundPosition.x) > static_cast<double>(gMAX_GRID_CELL_NUM) ||
+				Abs(roundPosition.y) > static_cast<double>(gMAX_GRID_CELL_NUM))
+			{
+				aOffGridIndices << i;
+				continue;
+			}
+
+			auto& tile = aGridTiles.emplace_back();
+			tile.index = i;
+			tile.position = Point{ static_cast<int32>(roundPosition.x), static_cast<int32>(roundPosition.y) };
+			tile.turn = static_cast<int32>(desc.turn);
+			tile.cell = tile.position + gTURN_CELL_OFFSETS[tile.turn];
+			tile.tileType = desc.tileType;
+
+			if (aGridTiles.size() == 1)
+			{
+				minCell = tile.cell;
+				maxCell = tile.cell;
+			}
+
+			minCell.x = Min(minCell.x, tile.cell.x);
+			minCell.y = Min(minCell.y, tile.cell.y);
+			maxCell.x = Max(maxCell.x, tile.cell.x);
+			maxCell.y = Max(maxCell.y, tile.cell.y);
+		}
+
+		if (aGridTiles.empty())
+		{
+			return {};
+		}
+
+		const Size cellNum = maxCell - minCell + Point{ 1, 1 };
+
+		// マスが多すぎる場合は全て個別に合成してもらう
+		if (static_cast<size_t>(cellNum.x) * static_cast<size_t>(cellNum.y) > gMAX_GRID_CELL_NUM)
+		{
+			for (const auto& tile : aGridTiles)
+			{
+				aOffGridIndices << tile.index;
+			}
+
+			std::sort(aOffGridIndices.begin(), aOffGridIndices.end());
+
+			return {};
+		}
+
+		// 各マスの4つの三角形のうち塗られているものをビットで持つ
+		Array<uint8> aMasks(static_cast<size_t>(cellNum.x) * cellNum.y, 0);
+
+		for (const auto& tile : aGridTiles)
+		{
+			const auto cell = tile.cell - minCell;
+			auto& mask = aMasks[static_cast<size_t>(cell.y) * cellNum.x + cell.x];
+
+			if (static_cast<Type>(tile.tileType) != Type::Triangle)
+			{
+				mask = 0xF;
+				continue;
+			}
+
+			// 三角形タイルは右下半分(x + y > 1)なので、各三角形の重心をタイルの向きに戻して調べる
+			for (int32 q = 0; q < gQUARTER_NUM; ++q)
+			{
+				const auto local = RotateQuarter(Vec2{ tile.cell - tile.position } + gQUARTER_CENTERS[q], gQUARTER_NUM - tile.turn);
+
+				if (local.x + local.y > 1.0)
+				{
+					mask |= static_cast<uint8>(1 << q);
+				}
+			}
+		}
+
+		// 頂点はマスの角とマスの中心
+		const uint32 cornerNum = static_cast<uint32>((cellNum.x + 1) * (cellNum.y + 1));
+		auto getCornerIndex = [&cellNum](const Point& position)
+		{
+			return static_cast<uint32>(position.y * (cellNum.x + 1) + position.x);
+		};
+		auto getCenterIndex = [&cellNum, cornerNum](const Point& cell)
+		{
+			return cornerNum + static_cast<uint32>(cell.y * cellNum.x + cell.x);
+		};
+		auto isFilled = [&cellNum, &aMasks](const Point& cell, int32 quarter)
+		{
+			if (cell.x < 0 || cell.y < 0 || cell.x >= cellNum.x || cell.y >= cellNum.y)
+			{
+				return false;
+			}
+
+			return ((aMasks[static_cast<size_t>(cell.y) * cellNum.x + cell.x] >> quarter) & 1) != 0;
+		};
+
+		// 塗られている三角形の辺のうち、隣が塗られていないものだけが輪郭になる
+		Array<Edge> aEdges;
+
+		for (int32 y = 0; y < cellNum.y; ++y)
+		{
+			for (int32 x = 0; x < cellNum.x; ++x)
+			{
+				const Point cell{ x, y };
+				const auto center = getCenterIndex(cell);
+
+				for (int32 q = 0; q < gQUARTER_NUM; ++q)
+				{
+					if (not isFilled(cell, q))
+					{
+						continue;
+					}
+
+					const auto begin = getCornerIndex(cell + gQUARTER_CORNERS[q]);
+					const auto end = getCornerIndex(cell + gQUARTER_CORNERS[(q + 1) % gQUARTER_NUM]);
+
+					if (not isFilled(cell + gQUARTER_NEIGHBORS[q], (q + 2) % gQUARTER_NUM))
+					{
+						aEdges << Edge{ begin, end };
+					}
+
+					if (not isFilled(cell, (q + 1) % gQUARTER_NUM))
+					{
+						aEdges << Edge{ end, center };
+					}
+
+					if (not isFilled(cell, (q + 3) % gQUARTER_NUM))
+					{
+						aEdges << Edge{ center, begin };
+					}
+				}
+			}
+		}
+
+		const auto aIndexLoops = ChainLoops(cornerNum + static_cast<size_t>(cellNum.x) * cellNum.y, aEdges);
+
+		// 頂点番号を半マス単位の座標に戻し、一直線に並んだ頂点を省く
+		auto getDoublePosition = [&cellNum, cornerNum](uint32 index)
+		{
+			if (index < cornerNum)
+			{
+				return Point{ static_cast<int32>(index % (cellNum.x + 1)), static_cast<int32>(index / (cellNum.x + 1)) } * 2;
+			}
+
+			index -= cornerNum;
+
+			return Point{ static_cast<int32>(index % cellNum.x), static_cast<int32>(index / cellNum.x) } * 2 + Point{ 1, 1 };
+		};
+
+		const Vec2 topLeft = *origin + Vec2{ minCell } * gTILE_SIZE;
+		Array<Array<Vec2>> aLoops;
+		aLoops.reserve(aIndexLoops.size());
+
+		for (const auto& indexLoop : aIndexLoops)
+		{
+			auto& loop = aLoops.emplace_back();
+
+			for (size_t i = 0, max = indexLoop.size(); i < max; ++i)
+			{
+				const auto prev = getDoublePosition(indexLoop[(i + max - 1) % max]);
+				const auto current = getDoublePosition(indexLoop[i]);
+				const auto next = getDoublePosition(indexLoop[(i + 1) % max]);
+				const auto a = current - prev;
+				const auto b = next - current;
+
+				if (a.x * b.y - a.y * b.x == 0)
+				{
+					continue;
+				}
+
+				loop << topLeft + Vec2{ current } * (gTILE_SIZE * 0.5);
+			}
+		}
+
+		return CreatePolygonsFromLoops(aLoops);
+	}
+
+	Array<Polygon> CreateUnion(const Array<Polygon>& aPolygons)
+	{
+		/** ****************************************************************************************************
+		 * @brief 分割・重複除去後の辺
+		 **************************************************************************************************** */
+		struct UnionEdge
+		{
+			uint32	left;		//!< x が小さい方の頂点
+			uint32	right;		//!< x が大きい方の頂点
+			int32	weight;		//!< 左から右へ向かう辺なら正、逆なら負(重なった数だけ増える)
+			int32	northWinding;	//!< 辺の上側の巻き数
+			int32	southWinding;	//!< 辺の下側の巻き数
+		};
+
+		// 全ての辺を集める(外周は時計回り、穴は反時計回りにそろえる)
+		Array<UnionSegment> aSegments;
+
+		auto addRing = [&aSegments](const Array<Vec2>& ring, bool isOuter)
+		{
+			if (ring.size() < 3)
+			{
+				return;
+			}
+
+			const bool isReverse = (CalcuSignedArea(ring) > 0.0) != isOuter;
+
+			for (size_t i = 0, max = ring.size(); i < max; ++i)
+			{
+				auto begin = SnapToUnionGrid(ring[i] / gUNION_PRECISION);
+				auto end = SnapToUnionGrid(ring[(i + 1) % max] / gUNION_PRECISION);
+
+				if (begin == end)
+				{
+					continue;
+				}
+
+				if (isReverse)
+				{
+					std::swap(begin, end);
+				}
+
+				auto& segment = aSegments.emplace_back();
+				segment.begin = begin;
+				segment.end = end;
+			}
+		};
+
+		for (const auto& polygon : aPolygons)
+		{
+			addRing(polygon.outer(), true);
+
+			for (const auto& inner : polygon.inners())
+			{
+				addRing(inner, false);
+			}
+		}
+
+		if (aSegments.empty())
+		{
+			return {};
+		}
+
+		// 交点と重なりの端で辺を分割する(丸めた交点で新しく交差ができることがあるので、交差が無くなるまで繰り返す)
+		for (int32 pass = 0; pass < gMAX_UNION_PASS; ++pass)
+		{
+			if (not FindSplits(aSegments))
+			{
+				break;
+			}
+
+			SplitSegments(aSegments);
+		}
+
+		// 頂点を溶接し、同じ位置の辺は向きを考慮して重みをまとめる
+		std::map<std::pair<double, double>, uint32> vertexIndices;
+		Array<Vec2> aVertices;
+
+		auto getVertexIndex = [&vertexIndices, &aVertices](const Vec2& position)
+		{
+			auto [itr, isInserted] = vertexIndices.try_emplace({ position.x, position.y }, static_cast<uint32>(aVertices.size()));
+
+			if (isInserted)
+			{
+				aVertices << position;
+			}
+
+			return itr->second;
+		};
+
+		std::map<std::pair<uint32, uint32>, int32> edgeWeights;
+
+		for (const auto& segment : aSegments)
+		{
+			const auto from = getVertexIndex(segment.begin);
+			const auto to = getVertexIndex(segment.end);
+
+			if (from < to)
+			{
+				++edgeWeights[{ from, to }];
+			}
+			else if (to < from)
+			{
+				--edgeWeights[{ to, from }];
+			}
+		}
+
+		Array<UnionEdge> aEdges;
+		Array<UnionEdge> aVerticalEdges;
+
+		for (const auto& [key, weight] : edgeWeights)
+		{
+			// 逆向きの辺が打ち消し合ったものは境界にならない
+			if (weight == 0)
+			{
+				continue;
+			}
+
+			UnionEdge edge{ key.first, key.second, weight, 0, 0 };
+			const auto& first = aVertices[key.first];
+			const auto& second = aVertices[key.second];
+
+			if (second.x < first.x || (second.x == first.x && second.y < first.y))
+			{
+				std::swap(edge.left, edge.right);
+				edge.weight = -edge.weight;
+			}
+
+			if (first.x == second.x)
+			{
+				aVerticalEdges << edge;
+			}
+			else
+			{
+				aEdges << edge;
+			}
+		}
+
+		// 左から右へ走査し、各辺の上下の巻き数を求める(縦の辺は左右の巻き数)
+		double sweepX = 0.0;
+		double probeY = 0.0;
+		static constexpr uint32 PROBE = std::numeric_limits<uint32>::max();
+
+		auto getY = [&aEdges, &aVertices, &sweepX, &probeY](uint32 index)
+		{
+			if (index == PROBE)
+			{
+				return probeY;
+			}
+
+			const auto& left = aVertices[aEdges[index].left];
+			const auto& right = aVertices[aEdges[index].right];
+
+			if (sweepX <= left.x)
+			{
+				return left.y;
+			}
+
+			if (right.x <= sweepX)
+			{
+				return right.y;
+			}
+
+			return left.y + (right.y - left.y) * (sweepX - left.x) / (right.x - left.x);
+		};
+
+		auto compare = [&aEdges, &aVertices, &getY](uint32 a, uint32 b)
+		{
+			const double aY = getY(a);
+			const double bY = getY(b);
+
+			if (aY != bY || a == PROBE || b == PROBE)
+			{
+				return aY < bY;
+			}
+
+			// 同じ点から出ている辺は、少し右で上にある方を先にする
+			const auto aVector = aVertices[aEdges[a].right] - aVertices[aEdges[a].left];
+			const auto bVector = aVertices[aEdges[b].right] - aVertices[aEdges[b].left];
+			const double cross = aVector.cross(bVector);
+
+			if (cross != 0.0)
+			{
+				return cross > 0.0;
+			}
+
+			return a < b;
+		};
+
+		std::set<uint32, decltype(compare)> activeEdges{ compare };
+		Array<std::set<uint32, decltype(compare)>::iterator> aActiveItrs(aEdges.size(), activeEdges.end());
+
+		// 直前の辺の下側の巻き数(無ければ外側)
+		auto getWinding = [&aEdges, &activeEdges](std::set<uint32, decltype(compare)>::iterator itr)
+		{
+			if (itr == activeEdges.begin())
+			{
+				return 0;
+			}
+
+			return aEdges[*std::prev(itr)].southWinding;
+		};
+
+		auto getVerticalWinding = [&aVertices, &activeEdges, &getWinding, &probeY](const UnionEdge& edge)
+		{
+			probeY = (aVertices[edge.left].y + aVertices[edge.right].y) * 0.5;
+
+			return getWinding(activeEdges.lower_bound(PROBE));
+		};
+
+		Array<uint32> aInsertOrder(aEdges.size());
+		std::iota(aInsertOrder.begin(), aInsertOrder.end(), 0);
+		// 同じ x から始まる辺は上から順に入れる(先に入れた辺の巻き数が後から変わらないように)
+		std::sort(aInsertOrder.begin(), aInsertOrder.end(), [&aEdges, &aVertices](uint32 a, uint32 b)
+			{
+				const auto& aLeft = aVertices[aEdges[a].left];
+				const auto& bLeft = aVertices[aEdges[b].left];
+
+				if (aLeft.x != bLeft.x)
+				{
+					return aLeft.x < bLeft.x;
+				}
+
+				if (aLeft.y != bLeft.y)
+				{
+					return aLeft.y < bLeft.y;
+				}
+
+				return (aVertices[aEdges[a].right] - aLeft).cross(aVertices[aEdges[b].right] - bLeft) > 0.0;
+			});
+
+		Array<uint32> aRemoveOrder{ aInsertOrder };
+		std::sort(aRemoveOrder.begin(), aRemoveOrder.end(), [&aEdges, &aVertices](uint32 a, uint32 b) { return aVertices[aEdges[a].right].x < aVertices[aEdges[b].right].x; });
+
+		std::sort(aVerticalEdges.begin(), aVerticalEdges.end(), [&aVertices](const UnionEdge& a, const UnionEdge& b) { return aVertices[a.left].x < aVertices[b.left].x; });
+
+		Array<double> aEventXs;
+		aEventXs.reserve(aVertices.size());
+		for (const auto& vertex : aVertices)
+		{
+			aEventXs << vertex.x;
+		}
+		std::sort(aEventXs.begin(), aEventXs.end());
+		aEventXs.erase(std::unique(aEventXs.begin(), aEventXs.end()), aEventXs.end());
+
+		size_t insertIndex = 0;
+		size_t removeIndex = 0;
+		size_t verticalIndex = 0;
+
+		for (auto x : aEventXs)
+		{
+			sweepX = x;
+
+			const size_t verticalBegin = verticalIndex;
+			while (verticalIndex < aVerticalEdges.size() && aVertices[aVerticalEdges[verticalIndex].left].x == x)
+			{
+				// 左側は更新前の状態で調べる
+				aVerticalEdges[verticalIndex].northWinding = getVerticalWinding(aVerticalEdges[verticalIndex]);
+				++verticalIndex;
+			}
+
+			while (removeIndex < aRemoveOrder.size() && aVertices[aEdges[aRemoveOrder[removeIndex]].right].x == x)
+			{
+				activeEdges.erase(aActiveItrs[aRemoveOrder[removeIndex]]);
+				++removeIndex;
+			}
+
+			while (insertIndex < aInsertOrder.size() && aVertices[aEdges[aInsertOrder[insertIndex]].left].x == x)
+			{
+				const auto index = aInsertOrder[insertIndex];
+				auto& edge = aEdges[index];
+				const auto itr = activeEdges.insert(index).first;
+
+				// 左から右へ向かう辺は下側(右手側)が内側
+				edge.northWinding = getWinding(itr);
+				edge.southWinding = edge.northWinding + edge.weight;
+				aActiveItrs[index] = itr;
+
+				++insertIndex;
+			}
+
+			for (size_t i = verticalBegin; i < verticalIndex; ++i)
+			{
+				aVerticalEdges[i].southWinding = getVerticalWinding(aVerticalEdges[i]);
+			}
+		}
+
+		// 内側と外側の境目になっている辺だけを、右手側が内側になる向きで取り出す
+		Array<Edge> aBoundaryEdges;
+
+		for (const auto& edge : aEdges)
+		{
+			const bool isNorthInside = edge.northWinding > 0;
+			const bool isSouthInside = edge.southWinding > 0;
+
+			if (isNorthInside == isSouthInside)
+			{
+				continue;
+			}
+
+			aBoundaryEdges << (isSouthInside ? Edge{ edge.left, edge.right } : Edge{ edge.right, edge.left });
+		}
+
+		for (const auto& edge : aVerticalEdges)
+		{
+			// 縦の辺は上から下へ並べてあり、northWinding が左側、southWinding が右側
+			const bool isWestInside = edge.northWinding > 0;
+			const bool isEastInside = edge.southWinding > 0;
+
+			if (isWestInside == isEastInside)
+			{
+				continue;
+			}
+
+			aBoundaryEdges << (isWestInside ? Edge{ edge.left, edge.right } : Edge{ edge.right, edge.left });
+		}
+
+		const auto aIndexLoops = ChainLoops(aVertices.size(), aBoundaryEdges);
+
+		// 一直線に並んだ頂点を省いて元の座標に戻す
+		Array<Array<Vec2>> aLoops;
+		aLoops.reserve(aIndexLoops.size());
+
+		for (const auto& indexLoop : aIndexLoops)
+		{
+			auto& loop = aLoops.emplace_back();
+
+			for (size_t i = 0, max = indexLoop.size(); i < max; ++i)
+			{
+				const auto& prev = aVertices[indexLoop[(i + max - 1) % max]];
+				const auto& current = aVertices[indexLoop[i]];
+				const auto& next = aVertices[indexLoop[(i + 1) % max]];
+
+				if ((current - prev).cross(next - current) == 0.0)
+				{
+					continue;
+				}
+
+				loop << current * gUNION_PRECISION;
+			}
+		}
+
+		return CreatePolygonsFromLoops(aLoops);
+	}
+
+	const Polygon& GetUnitHitBox(const TypeIndex tileType) noexcept
+	{
+		// 別スレッドでのステージ生成からも呼ばれるので関数内の静的変数で初期化する
+		static const std::array<Polygon, static_cast<size_t>(Type::Max) + 1U> aUnitHitBoxes = {
+			Polygon{ Vec2{ 0.0, 0.0 }, Vec2{ 1.0, 0.0 }, Vec2{ 1.0, 1.0 }, Vec2{ 0.0, 1.0 } },
+			Polygon{ Vec2{ 1.0, 0.0 }, Vec2{ 1.0, 1.0 }, Vec2{ 0.0, 1.0 } },
+			Polygon{ Vec2{ 0.0, 0.0 }, Vec2{ 1.0, 0.0 }, Vec2{ 1.0, 1.0 }, Vec2{ 0.0, 1.0 } }	// Max
+		};
+
+		return aUnitHitBoxes[Min<size_t>(tileType, static_cast<size_t>(Type::Max))];
+	}
+
+	Polygon CreateLocalHitBox(const Desc& desc)
+	{
+		return GetUnitHitBox(desc.tileType).
+			rotated(desc.GetAngle()).
+			scale(Vec2{ gTILE_SIZE, gTILE_SIZE }).
+			moveBy(desc.GetPosition());
+	}
+
+	Array<Polygon> CreateHitBoxes(const Array<Desc>& aTileDescs)
+	{
+		// 格子に乗っているタイルはまとめて合成する
+		Array<size_t> aOffGridIndices;
+		auto aHitBoxes = CreateGridHitBoxes(aTileDescs, aOffGridIndices);
+
+		// 格子に乗っていないタイルがあれば、合成済みのものと一度にまとめて合成する
+		if (not aOffGridIndices.empty())
+		{
+			for (auto index : aOffGridIndices)
+			{
+				aHitBoxes << CreateLocalHitBox(aTileDescs[index]);
+			}
+
+			aHitBoxes = CreateUnion(aHitBoxes);
+		}
+
+		GetSimplePolygon(aHitBoxes, 2.0, 0.00001);
+
+		return aHitBoxes;
+	}
+
+	uint64 CalcuHitBoxHash(const Array<Desc>& aTileDescs) noexcept
+	{
+		static constexpr uint64 FNV_OFFSET_BASIS = 14695981039346656037ULL;
+		static constexpr uint64 FNV_PRIME = 1099511628211ULL;
+
+		uint64 hash = FNV_OFFSET_BASIS;
+
+		auto append = [&hash](const void* pData, const size_t size)
+		{
+			const auto pBytes = static_cast<const uint8*>(pData);
+
+			for (size_t i = 0; i < size; ++i)
+			{
+				hash ^= pBytes[i];
+				hash *= FNV_PRIME;
+			}
+		};
+
+		const uint64 tileNum = aTileDescs.size();
+		append(&gHIT_BOX_VERSION, sizeof(gHIT_BOX_VERSION));
+		append(&tileNum, sizeof(tileNum));
+
+		// UV は見た目だけなので含めない
+		for (const auto& desc : aTileDescs)
+		{
+			append(&desc.x, sizeof(GridIndex));
+			append(&desc.y, sizeof(GridIndex));
+			append(&desc.turn, sizeof(Turn));
+			append(&desc.tileType, sizeof(TypeIndex));
+		}
+
+		// 0 は「事前合成なし」を表すので避ける
+		return (hash == 0) ? 1 : hash;
+	}
 }
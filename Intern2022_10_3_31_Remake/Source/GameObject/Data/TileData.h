@@ -12,6 +12,7 @@
 namespace MySystem::TileData
 {
 	using TypeIndex = uint8;	//!< タイルの種類用
+	using GridIndex = int16;	//!< 配置の単位での座標用
 
 	/** ****************************************************************************************************
 	 * @brief タイルの種類
@@ -26,31 +27,163 @@ namespace MySystem::TileData
 	static constexpr double	gTILE_SIZE = 30.0;		//!< タイルの大きさ
 	static constexpr Point	gUV_CELL_NUM{ 16, 32 }; //!< タイルテクスチャの分割数
 	static const String		gTEXTURE_PATH = U"Assets/Image/Tile.png";	//!< テクスチャのパス
+	static constexpr size_t	gMAX_GRID_CELL_NUM = 4096;	//!< 格子で合成できるマスの最大数
+	static constexpr double	gUNION_PRECISION = 1.0 / 1024.0;	//!< 合成時に同じ位置とみなす細かさ
+	static constexpr uint64	gHIT_BOX_VERSION = 2;	//!< 当たり判定の合成手順のバージョン(変えたら事前合成したものを使わなくなる)
+
+	static constexpr double	gGRID_SIZE = gTILE_SIZE * 0.5;	//!< 配置の単位(背景が奇数マスのカケラではタイルが半マスずれる)
+	static constexpr double	gQUANTIZE_EPSILON = 0.001;		//!< 配置の単位に乗っているとみなす誤差(単位に対する割合)
 
 	/** ****************************************************************************************************
-	 * @brief タイルのデータ格納用
+	 * @brief 90度単位の回転
 	 **************************************************************************************************** */
-	struct Desc
+	enum class Turn : uint8
+	{
+		Deg0,		//!< 回転なし
+		Deg90,		//!< 90度
+		Deg180,		//!< 180度
+		Deg270,		//!< 270度
+		Max
+	};
+
+	/** ****************************************************************************************************
+	 * @brief				座標を配置の単位に丸める
+	 * @param[in] value		座標
+	 * @param[out] rIndex	配置の単位での座標(範囲外なら端の値)
+	 * @retval true			丸める前から単位に乗っていた
+	 * @retval false		単位に乗っていないか範囲外
+	 **************************************************************************************************** */
+	inline bool QuantizePosition(const double value, GridIndex& rIndex) noexcept
 	{
-		Vec2 position;	//!< 表示座標
-		double angle;	//!< 表示角度
-		Point uv;		//!< UV開始位置
+		static constexpr double MIN = std::numeric_limits<GridIndex>::min();
+		static constexpr double MAX = std::numeric_limits<GridIndex>::max();
+
+		const double grid = value / gGRID_SIZE;
+		const double roundGrid = Clamp(Round(grid), MIN, MAX);
+
+		rIndex = static_cast<GridIndex>(roundGrid);
 
-		TypeIndex tileType;	//!< タイルの種類
+		return Abs(grid - roundGrid) <= gQUANTIZE_EPSILON;
+	}
+
+	/** ****************************************************************************************************
+	 * @brief				角度を90度単位に丸める
+	 * @param[in] angle		角度(ラジアン)
+	 * @param[out] rTurn	90度単位の回転
+	 * @retval true			丸める前から90度単位だった
+	 * @retval false		90度単位ではなかった
+	 **************************************************************************************************** */
+	inline bool QuantizeAngle(const double angle, Turn& rTurn) noexcept
+	{
+		static constexpr int64 TURN_NUM = static_cast<int64>(Turn::Max);
+
+		const double turn = angle / Math::HalfPi;
+		const double roundTurn = Round(turn);
+
+		rTurn = static_cast<Turn>(((static_cast<int64>(roundTurn) % TURN_NUM) + TURN_NUM) % TURN_NUM);
+
+		return Abs(turn - roundTurn) <= gQUANTIZE_EPSILON;
+	}
+
+	/** ****************************************************************************************************
+	 * @brief タイルのデータ格納用(格子に乗っている前提で詰めて持ち、生成する時に実数に戻す)
+	 **************************************************************************************************** */
+	struct Desc
+	{
+		GridIndex	x;			//!< 表示座標(配置の単位)
+		GridIndex	y;			//!< 表示座標(配置の単位)
+		uint16		uv;			//!< UV開始位置(行 * gUV_CELL_NUM.x + 列)
+		Turn		turn;		//!< 表示角度
+		TypeIndex	tileType;	//!< タイルの種類
 
 		/** ****************************************************************************************************
 		 * @brief コンストラクタ
 		 **************************************************************************************************** */
 		inline Desc() noexcept :
-			position{ Vec2{ 0.0, 0.0 } },
-			angle{ 0.0 },
-			uv{ Point{ 0, 0 } },
+			x{ 0 },
+			y{ 0 },
+			uv{ 0 },
+			turn{ Turn::Deg0 },
 			tileType{ static_cast<TypeIndex>(0) }
 		{
 
 		}
+
+		/** ****************************************************************************************************
+		 * @brief	表示座標を取得
+		 * @return	表示座標
+		 **************************************************************************************************** */
+		inline Vec2 GetPosition() const noexcept
+		{
+			return Vec2{ x * gGRID_SIZE, y * gGRID_SIZE };
+		}
+
+		/** ****************************************************************************************************
+		 * @brief	表示角度を取得
+		 * @return	表示角度(ラジアン)
+		 **************************************************************************************************** */
+		inline double GetAngle() const noexcept
+		{
+			return static_cast<double>(turn) * Math::HalfPi;
+		}
+
+		/** ****************************************************************************************************
+		 * @brief	UV開始位置を取得
+		 * @return	UV開始位置
+		 **************************************************************************************************** */
+		inline Point GetUV() const noexcept
+		{
+			return Point{ uv % gUV_CELL_NUM.x, uv / gUV_CELL_NUM.x };
+		}
+
+		/** ****************************************************************************************************
+		 * @brief				表示座標を設定(配置の単位に丸める)
+		 * @param[in] position	表示座標
+		 * @retval true			丸める前から単位に乗っていた
+		 * @retval false		単位に乗っていないか範囲外
+		 **************************************************************************************************** */
+		inline bool SetPosition(const Vec2& position) noexcept
+		{
+			const bool isOnGridX = QuantizePosition(position.x, x);
+			const bool isOnGridY = QuantizePosition(position.y, y);
+
+			return isOnGridX && isOnGridY;
+		}
+
+		/** ****************************************************************************************************
+		 * @brief				表示角度を設定(90度単位に丸める)
+		 * @param[in] angle		表示角度(ラジアン)
+		 * @retval true			丸める前から90度単位だった
+		 * @retval false		90度単位ではなかった
+		 **************************************************************************************************** */
+		inline bool SetAngle(const double angle) noexcept
+		{
+			return QuantizeAngle(angle, turn);
+		}
+
+		/** ****************************************************************************************************
+		 * @brief				UV開始位置を設定
+		 * @param[in] cell		UV開始位置
+		 * @retval true			テクスチャの範囲内だった
+		 * @retval false		テクスチャの範囲外だった(設定しない)
+		 **************************************************************************************************** */
+		inline bool SetUV(const Point& cell) noexcept
+		{
+			if (cell.x < 0 || gUV_CELL_NUM.x <= cell.x || cell.y < 0 || gUV_CELL_NUM.y <= cell.y)
+			{
+				return false;
+			}
+
+			uv = static_cast<uint16>(cell.y * gUV_CELL_NUM.x + cell.x);
+
+			return true;
+		}
+
+		bool operator==(const Desc&) const = default;
 	};
 
+	static_assert(sizeof(Desc) == 8);
+
 	/** ****************************************************************************************************
 	 * @brief						ポリゴンから出来るだけ重複している頂点を削除する
 	 * @param[out] targets			対象のポリゴン
@@ -66,5 +199,47 @@ namespace MySystem::TileData
 	 * @param[in] nearLineDistance	同じ線状とみなす距離
 	 **************************************************************************************************** */
 	Array<Vec2> GetSimpleVertex(Array<Vec2> targets, double nearPointDistance, double nearLineDistance);
-}
 
+	/** ****************************************************************************************************
+	 * @brief						格子に乗っているタイルの当たり判定を塗りつぶしでまとめて合成する
+	 * @param[in] aTileDescs		対象のタイル群
+	 * @param[out] aOffGridIndices	格子に乗っていないため合成しなかったタイルの番号
+	 * @return						合成した当たり判定
+	 **************************************************************************************************** */
+	Array<Polygon> CreateGridHitBoxes(const Array<Desc>& aTileDescs, Array<size_t>& aOffGridIndices);
+
+	/** ****************************************************************************************************
+	 * @brief					複数のポリゴンを一度にまとめて合成する
+	 * @param[in] aPolygons		対象のポリゴン群
+	 * @return					合成したポリゴン群
+	 **************************************************************************************************** */
+	Array<Polygon> CreateUnion(const Array<Polygon>& aPolygons);
+
+	/** ****************************************************************************************************
+	 * @brief				タイルの種類ごとの大きさ 1 の当たり判定を取得
+	 * @param[in] tileType	タイルの種類
+	 * @return				当たり判定
+	 **************************************************************************************************** */
+	const Polygon& GetUnitHitBox(const TypeIndex tileType) noexcept;
+
+	/** ****************************************************************************************************
+	 * @brief				カケラ内でのタイルの当たり判定を生成
+	 * @param[in] desc		対象のタイル
+	 * @return				当たり判定
+	 **************************************************************************************************** */
+	Polygon CreateLocalHitBox(const Desc& desc);
+
+	/** ****************************************************************************************************
+	 * @brief					カケラ1枚分のタイルの当たり判定を合成して単純化する
+	 * @param[in] aTileDescs	対象のタイル群
+	 * @return					合成した当たり判定
+	 **************************************************************************************************** */
+	Array<Polygon> CreateHitBoxes(const Array<Desc>& aTileDescs);
+
+	/** ****************************************************************************************************
+	 * @brief					当たり判定に関わる内容から FNV-1a でハッシュを計算(0 にはならない)
+	 * @param[in] aTileDescs	対象のタイル群
+	 * @return					ハッシュ
+	 **************************************************************************************************** */
+	uint64 CalcuHitBoxHash(const Array<Desc>& aTileDescs) noexcept;
+}
@@ -21,7 +21,7 @@ namespace MySystem
 		 * @param[in] pParent	親
 		 **************************************************************************************************** */
 		Impl(const GimmickData::Desc& data, Transform* pParent) :
-			transform{ data.position, Vec2{ 1.0, 1.0 }, data.angle, pParent },
+			transform{ data.GetPosition(), Vec2{ 1.0, 1.0 }, data.GetAngle(), pParent },
 			type{ data.gimmickType },
 			flag{ BitFlag::GetMask(GimmickData::gENABLE, GimmickData::gACTIVE) }
 		{
@@ -41,7 +41,7 @@ namespace MySystem
 				return;
 			}
 
-			GetBody()(TextureAsset(GimmickData::gLABEL_TEXTURE[type])).draw();
+			GetBody()(GimmickData::GetTexture(type)).draw();
 		}
 
 		/** ****************************************************************************************************
@@ -91,7 +91,7 @@ namespace MySystem
 
 	}
 
-	void Goal::Update()
+	void Goal::Update(const double deltaTime, const InputData::State& input)
 	{
 
 	}
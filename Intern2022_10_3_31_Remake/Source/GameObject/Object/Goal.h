@@ -35,7 +35,7 @@ namespace MySystem
 		 **************************************************************************************************** */
 		~Goal();
 
-		void Update() override;
+		void Update(const double deltaTime, const InputData::State& input) override;
 
 		void Draw() const override;
 
@@ -2,7 +2,6 @@
 #include "../Data/Transform.h"
 #include "../Data/TileData.h"
 #include "../../Utility/BitFlag.h"
-#include "../../Utility/CommonKey.h"
 #include "../../Utility/MyMath.h"
 
 namespace MySystem
@@ -24,6 +23,7 @@ namespace MySystem
 		static constexpr double _DECREMENT_SPEED = _MAX_SPEED * 2;	//!< 横方向速度減少量
 		static constexpr double _GRAVITY = 9.8;						//!< 重力
 		static constexpr double _JUMP_POWER = -3.0;					//!< ジャンプ時の速度
+		static constexpr size_t _MAX_HIT_ITERATION = 4;				//!< 1回の移動で壁に沿わせる最大回数
 
 		//! 表示サイズ
 		static constexpr Vec2 _BODEY_SIZE{ TileData::gTILE_SIZE, TileData::gTILE_SIZE * (static_cast<double>(_SIZE_UV_WIDTH_HEIGHT.y) / static_cast<double>(_SIZE_UV_WIDTH_HEIGHT.x)) };
@@ -38,7 +38,15 @@ namespace MySystem
 		Vec2	right;	//!< 右向きベクトル
 		Vec2	speed;	//!< 速度(横と縦)
 
-		int	animationFrame;	//!< アニメーションのフレーム
+		Vec2	prevPosition;	//!< 前回の更新前の場所(描画の補間用)
+		double	interpolation;	//!< 描画の補間割合
+
+		int		animationFrame;	//!< アニメーションのフレーム
+		double	animationTime;	//!< アニメーションに使う時間
+
+		Array<uint32>	aCandidates;	//!< 当たり判定を取る線分番号(使いまわし用)
+		Array<uint32>	aBlockIndices;	//!< segmentBlock の各線分の線分番号(使いまわし用)
+		MyMath::SegmentBlock	segmentBlock;	//!< 当たり判定を取る線分群(使いまわし用)
 
 		/** ****************************************************************************************************
 		 * @brief				コンストラクタ
@@ -46,9 +54,12 @@ namespace MySystem
 		 * @param[in] pParent	親
 		 **************************************************************************************************** */
 		Impl(const GimmickData::Desc& data, Transform* pParent) :
-			transform{ data.position, Vec2{ 1.0, 1.0 }, data.angle, pParent },
+			transform{ data.GetPosition(), Vec2{ 1.0, 1.0 }, data.GetAngle(), pParent },
 			type{ data.gimmickType },
-			flag{ BitFlag::GetMask(GimmickData::gENABLE, GimmickData::gACTIVE) }
+			flag{ BitFlag::GetMask(GimmickData::gENABLE, GimmickData::gACTIVE) },
+			interpolation{ 1.0 },
+			animationFrame{ 0 },
+			animationTime{ 0.0 }
 		{
 			auto bodyScale = Vec2{ TileData::gTILE_SIZE, TileData::gTILE_SIZE };
 			bodyScale /= 2.0;
@@ -56,14 +67,16 @@ namespace MySystem
 			bodyScale.y += bodyScale.y - _BODEY_SIZE.y / 2.0;
 
 			transform.SetLocalPosition(transform.GetLocalPosition() + bodyScale);
+
+			prevPosition = transform.GetWorldPosition();
 		}
 
 		/** ****************************************************************************************************
 		 * @brief					当たり判定
-		 * @oaram[in] aGroundLines	地面の線分
+		 * @oaram[in] groundGrid	地面の線分
 		 * @param[in] apGimmicks	ギミック群
 		 **************************************************************************************************** */
-		void HitCheck(const Array<LineString>& aGroundLines, const Array<std::weak_ptr<GimmickData::Gimmick>>& apGimmicks)
+		void HitCheck(const GroundData::Grid& groundGrid, const Array<std::weak_ptr<GimmickData::Gimmick>>& apGimmicks)
 		{
 			if (speed == Vec2::Zero())
 			{
@@ -71,9 +84,6 @@ namespace MySystem
 				return;
 			}
 
-			bool isReverse = false;				// 前回鋭角によって反転したか
-			Line* pPrevHitLine = nullptr;		// 前回の線分に比べて反転したかどうか
-			Vec2 prevNormal;					// 前回の線分の法線(角度計算用)
 			auto collision = GetCollision();	// 自分の当たり判定
 
 			// 現在のスピード
@@ -81,47 +91,95 @@ namespace MySystem
 
 			BitFlag::UnPop(flag, _IS_GROUND);
 
-			for (auto i : step(10))
+			for (auto i : step(_MAX_HIT_ITERATION))
 			{
-				auto speedRight = Vec2{ -currentSpeed.y, currentSpeed.x };	// スピードの右向きベクトル
-				double maxDistance = currentSpeed.length();					// 移動できる距離
-				Vec2 HitPosition;	// 当たった場所
-				Vec2 hitNormal;		// 当たったモノの法線
+				double maxDistance = currentSpeed.length();	// 移動できる距離
+				Vec2 hitNormal;						// 当たったモノの法線
 				Vec2 nextSpeed = currentSpeed;		// 当たり判定後のスピード
 				bool hitFlag = false;				// あたったかどうか
-				Line* pCurrentHitLine = nullptr;	// 当たった線分
 
-				for (auto lineString : aGroundLines)
+				// 移動範囲に掛かる線分だけを調べる
+				{
+					const auto margin = collision.r;
+					const auto from = collision.center;
+					const auto to = collision.center + currentSpeed;
+
+					groundGrid.Query(
+						RectF{
+							Min(from.x, to.x) - margin,
+							Min(from.y, to.y) - margin,
+							Abs(to.x - from.x) + margin * 2.0,
+							Abs(to.y - from.y) + margin * 2.0
+						},
+						aCandidates
+					);
+				}
+
+				const auto& aSegments = groundGrid.GetSegments();
+
+				// 線分を法線方向に半径分ずらせば、面との接触は中心の移動線分との交差になる
+				segmentBlock.Clear();
+				aBlockIndices.clear();
+
+				for (auto index : aCandidates)
 				{
-					for (size_t j = 0, max = lineString.num_lines(CloseRing::Yes); j < max; ++j)
+					const auto& segment = aSegments[index];	// 対象の線分
+
+					// 離れていく向きの面には当たらない(端点は隣の面の分で調べられる)
+					if (currentSpeed.dot(segment.normal) >= 0.0)
 					{
-						auto line = lineString.line(j, CloseRing::Yes);	// 対象の線分
+						continue;
+					}
 
-						//法線取得
-						auto normal = lineString.normalAtLine(j, CloseRing::Yes);
+					const auto line = segment.line.movedBy(segment.normal * collision.r);
 
-						// 移動先にないなら無視する
-						if (speedRight.cross(normal) < 0.0)
-						{
-							continue;
-						}
+					segmentBlock.Add(line.begin, line.end);
+					aBlockIndices << index;
+				}
+
+				double hitTime = 1.0;	// 一番早く当たった割合
 
-						// 線分に寄せたスピードベクトル
-						auto speedVec = Line{ (-normal * collision.r) + collision.center, (-normal * collision.r) + collision.center + currentSpeed };
+				{
+					size_t hitIndex;	// 当たった線分
+					double faceTime;	// 当たった割合
+					Vec2 point;			// 当たった位置
+
+					if (MyMath::HitCheckSegmentToSegments(collision.center, collision.center + currentSpeed, segmentBlock, hitTime, hitIndex, faceTime, point))
+					{
+						hitTime		= Abs(faceTime);
+						nextSpeed	= point - collision.center;
+						hitNormal	= aSegments[aBlockIndices[hitIndex]].normal;
+						hitFlag		= true;
+					}
+				}
+
+				// 面より先に角に当たる場合
+				for (auto index : aBlockIndices)
+				{
+					const auto& line = aSegments[index].line;
+
+					for (const auto& corner : { line.begin, line.end })
+					{
+						double cornerTime;	// 当たった割合
 
-						// 当たってないなら無視する
-						if (not HitCheck(line.stretched(collision.r, collision.r), speedVec, HitPosition, maxDistance))
+						if (not MyMath::CalcuSweptCircleToPoint(collision.center, currentSpeed, collision.r, corner, cornerTime) ||
+							cornerTime >= hitTime)
 						{
 							continue;
 						}
 
-						pCurrentHitLine	= &line;
-						nextSpeed		= HitPosition;
-						hitNormal		= normal;
-						hitFlag			= true;
+						hitTime		= cornerTime;
+						nextSpeed	= currentSpeed * cornerTime;
+						hitNormal	= (collision.center + nextSpeed - corner).normalized();
+						hitFlag		= true;
 					}
 				}
 
+				if (hitFlag)
+				{
+					maxDistance = nextSpeed.length();
+				}
+
 				for (auto pGimmick : apGimmicks)
 				{
 					auto pRawGimmick = pGimmick.lock();
@@ -143,6 +201,7 @@ namespace MySystem
 
 				// 場所の更新
 				transform.SetWorldPosition(transform.GetWorldPosition() + nextSpeed);
+				collision.center += nextSpeed;
 
 				// 何も当たっていないならこれ以上判定しない
 				if (not hitFlag)
@@ -150,11 +209,12 @@ namespace MySystem
 					break;
 				}
 
+				// 残りの移動量を接した面に沿わせる
 				currentSpeed = MyMath::CalcuWallScratchVector(currentSpeed - nextSpeed, -hitNormal);
 
 				{
 					// 地面の角度
-					auto theta = acos(down.dot(hitNormal));
+					auto theta = acos(Clamp(down.dot(hitNormal), -1.0, 1.0));
 
 					if (theta > 140.0_deg)		// 地面判定
 					{
@@ -176,33 +236,6 @@ namespace MySystem
 				{
 					break;
 				}
-
-				if (pCurrentHitLine)
-				{
-					if (pPrevHitLine)
-					{
-						// 前回の線分との角度を取る
-						auto theta = acos(prevNormal.dot(hitNormal));
-
-						// 鋭角の場合移動ベクトルを反転
-						if (theta > 90.0_deg)
-						{
-							// ただし連続で反転できないようにする
-							if (!isReverse)
-							{
-								isReverse = true;
-								currentSpeed *= -1.0;
-							}
-						}
-						else
-						{
-							isReverse = false;
-						}
-					}
-
-					pPrevHitLine	= pCurrentHitLine;
-					prevNormal		= hitNormal;
-				}
 			}
 		}
 
@@ -236,106 +269,82 @@ namespace MySystem
 			return false;
 		}
 
-		/** ****************************************************************************************************
-		 * @brief					地面との当たり判定
-		 * @oaram[in] groundLine	地面の線分
-		 * @param[in] speedVec		自信のスピードベクトル
-		 * @param[out] hitPosition	当たった場所
-		 * @param[out] maxDistance	現在の最大移動距離
-		 * @retval true				当たった
-		 * @retval false			当たっていない
-		 **************************************************************************************************** */
-		bool HitCheck(const Line& groundLine, const Line& speedVec, Vec2& hitPosition, double& maxDistance)
-		{
-			double hitTime;	// 当たった割合
-			Vec2 point;		// 当たった位置
-
-			if (MyMath::HitCheckSegmentToSegment(speedVec.begin, speedVec.end, groundLine.begin, groundLine.end, hitTime, point))
-			{
-				// 当たった位置までの距離
-				float nextDistance = (point - speedVec.begin).length();
-
-				// 現在より遠い位置なら無視する
-				if (nextDistance >= maxDistance)
-					return false;
-
-				hitPosition = point - speedVec.begin;
-				maxDistance = nextDistance;
-
-				return true;
-			}
-
-			return false;
-		}
-
 		/** ****************************************************************************************************
 		 * @brief						速度を追加
 		 * @oaram[in] incrementSpeed	追加する値
+		 * @param[in] deltaTime			1回の更新で進める時間
 		 **************************************************************************************************** */
-		void IncrementSpeed(double incrementSpeed)
+		void IncrementSpeed(double incrementSpeed, const double deltaTime)
 		{
-			speed.x += incrementSpeed * Scene::DeltaTime();
+			speed.x += incrementSpeed * deltaTime;
 
 			speed.x = Clamp(speed.x, -_MAX_SPEED, _MAX_SPEED);
 		}
 
 		/** ****************************************************************************************************
-		 * @brief 速度を減らす
+		 * @brief					速度を減らす
+		 * @param[in] deltaTime		1回の更新で進める時間
 		 **************************************************************************************************** */
-		void DecrementSpeed()
+		void DecrementSpeed(const double deltaTime)
 		{
 			if (speed.x > 0.0)
 			{
-				speed.x -= _DECREMENT_SPEED * Scene::DeltaTime();
+				speed.x -= _DECREMENT_SPEED * deltaTime;
 
 				speed.x = Max(speed.x, 0.0);
 			}
 			else if (speed.x < 0.0)
 			{
-				speed.x += _DECREMENT_SPEED * Scene::DeltaTime();
+				speed.x += _DECREMENT_SPEED * deltaTime;
 
 				speed.x = Min(speed.x, 0.0);
 			}
 		}
 
 		/** ****************************************************************************************************
-		 * @brief 更新
+		 * @brief					更新
+		 * @param[in] deltaTime		1回の更新で進める時間
+		 * @param[in] input			入力の状態
 		 **************************************************************************************************** */
-		void Update()
+		void Update(const double deltaTime, const InputData::State& input)
 		{
+			prevPosition = transform.GetWorldPosition();
+
 			if (BitFlag::CheckAnyUnPop(flag, BitFlag::GetMask(GimmickData::gENABLE, GimmickData::gACTIVE)))
 			{
 				return;
 			}
 
-			if (CommonKeyState::gINPUT_LEFT.pressed())
+			animationTime += deltaTime;
+
+			if (input.isLeftPressed)
 			{
-				IncrementSpeed(-_INCREMENT_SPEED);
+				IncrementSpeed(-_INCREMENT_SPEED, deltaTime);
 			}
-			else if (CommonKeyState::gINPUT_RIGHT.pressed())
+			else if (input.isRightPressed)
 			{
-				IncrementSpeed(_INCREMENT_SPEED);
+				IncrementSpeed(_INCREMENT_SPEED, deltaTime);
 			}
 			else
 			{
-				DecrementSpeed();
+				DecrementSpeed(deltaTime);
 			}
 
 			if (BitFlag::CheckAnyPop(flag, _IS_GROUND))
 			{
-				if (CommonKeyState::gINPUT_JUMP.pressed())
+				if (input.isJumpPressed)
 				{
 					speed.y = _JUMP_POWER;
 				}
 			}
 			else
 			{
-				speed.y += _GRAVITY * Scene::DeltaTime();
+				speed.y += _GRAVITY * deltaTime;
 			}
 
 			if (speed.x != 0.0f)
 			{
-				animationFrame = (speed.x < 0 ? 6 : 12) + (int)(Periodic::Triangle0_1(0.5s) * 2.0 + 0.5);
+				animationFrame = (speed.x < 0 ? 6 : 12) + (int)(Periodic::Triangle0_1(0.5s, animationTime) * 2.0 + 0.5);
 			}
 		}
 
@@ -349,14 +358,17 @@ namespace MySystem
 				return;
 			}
 
-			auto texture = TextureAsset{ GimmickData::gLABEL_TEXTURE[type] };
+			const auto& texture = GimmickData::GetTexture(type);
 
 			auto orizinSize = texture.size() / _UV_CELL_NUM;
 
 			const int offsetU = (animationFrame % 6) * orizinSize.x + _OFFSET_UV_LEFT_TOP.x;
 			const int offsetV = (animationFrame / 6) * orizinSize.y + _OFFSET_UV_LEFT_TOP.y;
 
-			GetBody()(texture(offsetU, offsetV, _SIZE_UV_WIDTH_HEIGHT)).draw();
+			// 前回の更新前の場所から現在の場所までを補間して描画する
+			const auto offset = (prevPosition - transform.GetWorldPosition()) * (1.0 - interpolation);
+
+			GetBody().movedBy(offset)(texture(offsetU, offsetV, _SIZE_UV_WIDTH_HEIGHT)).draw();
 		}
 
 		/** ****************************************************************************************************
@@ -434,9 +446,9 @@ namespace MySystem
 	{
 	}
 
-	void Player::Update()
+	void Player::Update(const double deltaTime, const InputData::State& input)
 	{
-		_pImpl->Update();
+		_pImpl->Update(deltaTime, input);
 	}
 
 	void Player::Draw() const
@@ -489,8 +501,19 @@ namespace MySystem
 		_pImpl->UpdateDirection(angle);
 	}
 
-	void Player::HitCheck(const Array<LineString>& aGroundLines, const Array<std::weak_ptr<GimmickData::Gimmick>>& apGimmicks)
+	void Player::HitCheck(const GroundData::Grid& groundGrid, const Array<std::weak_ptr<GimmickData::Gimmick>>& apGimmicks)
+	{
+		_pImpl->HitCheck(groundGrid, apGimmicks);
+	}
+
+	void Player::SetInterpolation(const double interpolation)
+	{
+		_pImpl->interpolation = interpolation;
+	}
+
+	void Player::ResetInterpolation()
 	{
-		_pImpl->HitCheck(aGroundLines, apGimmicks);
+		_pImpl->prevPosition = _pImpl->transform.GetWorldPosition();
+		_pImpl->interpolation = 1.0;
 	}
 }
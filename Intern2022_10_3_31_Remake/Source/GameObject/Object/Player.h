@@ -6,6 +6,7 @@
 
 #include <Siv3D.hpp>
 #include "../Data/GimmickData.h"
+#include "../Data/GroundData.h"
 
 namespace MySystem
 {
@@ -35,7 +36,7 @@ namespace MySystem
 		 **************************************************************************************************** */
 		~Player();
 
-		void Update() override;
+		void Update(const double deltaTime, const InputData::State& input) override;
 
 		void Draw() const override;
 
@@ -66,10 +67,21 @@ namespace MySystem
 
 		/** ****************************************************************************************************
 		 * @brief					当たり判定
-		 * @oaram[in] aGroundLines	地面の線分
+		 * @oaram[in] groundGrid	地面の線分
 		 * @param[in] apGimmicks	ギミック群
 		 **************************************************************************************************** */
-		void HitCheck(const Array<LineString>& aGroundLines, const Array<std::weak_ptr<GimmickData::Gimmick>>& apGimmicks);
+		void HitCheck(const GroundData::Grid& groundGrid, const Array<std::weak_ptr<GimmickData::Gimmick>>& apGimmicks);
+
+		/** ****************************************************************************************************
+		 * @brief						描画時の補間割合を設定
+		 * @param[in] interpolation		前回の更新から次の更新までの割合
+		 **************************************************************************************************** */
+		void SetInterpolation(const double interpolation);
+
+		/** ****************************************************************************************************
+		 * @brief 描画時の補間をやめて現在の場所に描画する
+		 **************************************************************************************************** */
+		void ResetInterpolation();
 	};
 }
 
@@ -2,17 +2,19 @@
 #include "StagePiece.h"
 #include "Player.h"
 #include "Goal.h"
+#include "Tile.h"
 #include "../Data/Transform.h"
+#include "../Data/GroundData.h"
 #include "../../Utility/BitFlag.h"
-#include "../../Utility/CommonKey.h"
 
 namespace MySystem
 {
 	class Stage::Impl
 	{
 	private:
-		using _UpdateFunction = void (Stage::Impl::*)();		//!< 更新関数用
-		using _DrawFunction = void (Stage::Impl::*)() const;	//!< 描画関数用
+		using _UpdateFunction = void (Stage::Impl::*)(const InputData::State&);	//!< 更新関数用
+		using _FixedUpdateFunction = void (Stage::Impl::*)(const double, const InputData::State&);	//!< 固定時間での更新関数用
+		using _DrawFunction = void (Stage::Impl::*)(const RectF&) const;	//!< 描画関数用
 		using _Flag = uint16;
 
 		static constexpr _Flag _ENABLE = BitFlag::Get<_Flag>(0);			//!< 存在フラグ
@@ -29,16 +31,63 @@ namespace MySystem
 		static constexpr _Flag _MASK_GAME_END = BitFlag::GetMask<_Flag>(_CLEAR, _GAME_OVER);			//!< ゲームが終了したか判定用
 		static constexpr _Flag _MASK_CAUSE_GAME_OVER = BitFlag::GetMask<_Flag>(_FALL_OUT, _SCALE_OUT);	//!< ゲームオーバーに原因があるか判定用
 
+		/** ****************************************************************************************************
+		 * @brief カケラ1枚分の当たり判定の合成結果
+		 **************************************************************************************************** */
+		struct _HitBoxLayer
+		{
+			bool			isValid;		//!< 合成済みか
+			Quad			body;			//!< 合成した時のカケラの形
+			Polygon			backBox;		//!< 下の層を削る範囲
+			Array<Polygon>	aPieceHitBoxes;	//!< カケラ自身の当たり判定
+			Array<Polygon>	aHitBoxes;		//!< この層までを合成した当たり判定
+
+			/** ****************************************************************************************************
+			 * @brief コンストラクタ
+			 **************************************************************************************************** */
+			_HitBoxLayer() :
+				isValid{ false },
+				body{}
+			{
+
+			}
+
+			/** ****************************************************************************************************
+			 * @brief			合成した時から動いていないか
+			 * @param[in] other	現在のカケラの形
+			 * @retval true		動いていない
+			 * @retval false	動いた
+			 **************************************************************************************************** */
+			bool IsSameBody(const Quad& other) const
+			{
+				return isValid &&
+					body.p0 == other.p0 &&
+					body.p1 == other.p1 &&
+					body.p2 == other.p2 &&
+					body.p3 == other.p3;
+			}
+		};
+
 	public:
 		_Flag			flag;			//!< フラグ
 		Stage*			pStage;			//!< ステージの本体
 		Transform		transform;		//!< 座標
-		_UpdateFunction	pUpdate;		//!< 更新関数
+		_UpdateFunction	pUpdate;		//!< 更新関数(毎フレーム呼ぶ)
+		_FixedUpdateFunction	pFixedUpdate;	//!< 固定時間での更新関数
 		_DrawFunction	pDraw;			//!< 描画関数
 		double			animationTime;	//!< アニメーションに使う時間
+		CursorStyle		cursorStyle;	//!< カーソルが指している操作に合うカーソルの形
 		BasicCamera2D	camera;			//!< カメラ
 		Array<std::unique_ptr<StagePiece>>	apPiece;	//!< カケラ
 		Array<Polygon>						aHitBoxes;	//!< ステージ当たり判定
+		Array<_HitBoxLayer>					aHitBoxLayers;	//!< カケラごとの当たり判定の合成結果
+		bool								isHitBoxCreated;	//!< 当たり判定が生成済みか
+		Array<Polygon>						aWorldHitBoxes;	//!< ワールド座標のステージ当たり判定
+		GroundData::Grid					groundGrid;	//!< ワールド座標の地面の線分
+		bool								isGroundCreated;	//!< ワールド座標の当たり判定が生成済みか
+		Vec2								groundPosition;	//!< ワールド座標の当たり判定を生成した時の座標
+		Vec2								groundScale;	//!< ワールド座標の当たり判定を生成した時の大きさ
+		double								groundAngle;	//!< ワールド座標の当たり判定を生成した時の角度
 		Array<std::shared_ptr<Player>>		apPlayers;	//!< プレイヤー
 		Array<std::shared_ptr<Goal>>		apGoals;	//!< ゴール
 		Array<std::shared_ptr<GimmickData::Gimmick>>	apGimmicks;	//!< カケラに所属しないギミック
@@ -55,35 +104,92 @@ namespace MySystem
 			pStage{ pStage },
 			transform{ position, scale, angle, pParent },
 			pUpdate{ &Stage::Impl::UpdatePieceAction },
+			pFixedUpdate{ nullptr },
 			pDraw{ &Stage::Impl::DrawPieceAction },
 			animationTime{ 0.0 },
-			camera{ }
+			cursorStyle{ CursorStyle::Default },
+			camera{ },
+			isHitBoxCreated{ false },
+			isGroundCreated{ false },
+			groundPosition{},
+			groundScale{},
+			groundAngle{ 0.0 }
 		{
 			camera.setCenter(transform.GetWorldPosition());
-			FontAsset::Register(U"Stage", 30);
 		}
 
 		/** ****************************************************************************************************
-		 * @brief 更新
+		 * @brief				更新
+		 * @param[in] input		入力の状態
 		 **************************************************************************************************** */
-		void Update() noexcept
+		void Update(const InputData::State& input) noexcept
 		{
+			cursorStyle = CursorStyle::Default;
+
 			// 何らかの要因で有効化されていないなら実行しない
 			if (BitFlag::CheckAnyUnPop(flag, _MASK_ACTIVE))
 			{
 				return;
 			}
 
-			auto transformer = camera.createTransformer();
-
-			if (KeyEnter.down())
+			if (input.isRetryDown)
 			{
 				SetGameOverPlayerFallOut();
 			}
 
-			ChangeMode();
+			ChangeMode(input);
+
+			if (pUpdate)
+			{
+				(this->*pUpdate)(ToWorldInput(input));
+			}
+		}
+
+		/** ****************************************************************************************************
+		 * @brief					固定時間での更新
+		 * @param[in] deltaTime		1回の更新で進める時間
+		 * @param[in] input			入力の状態
+		 **************************************************************************************************** */
+		void FixedUpdate(const double deltaTime, const InputData::State& input) noexcept
+		{
+			// 何らかの要因で有効化されていないなら実行しない
+			if (BitFlag::CheckAnyUnPop(flag, _MASK_ACTIVE))
+			{
+				return;
+			}
+
+			// 同じフレームの前の更新でゲームが終わったなら、次の Update で切り替わるまでプレイヤーを動かさない
+			if (pFixedUpdate == &Stage::Impl::UpdatePlayerAction && IsGameEnd())
+			{
+				return;
+			}
 
-			(this->*pUpdate)();
+			if (pFixedUpdate)
+			{
+				(this->*pFixedUpdate)(deltaTime, ToWorldInput(input));
+			}
+		}
+
+		/** ****************************************************************************************************
+		 * @brief						描画時の補間割合を設定
+		 * @param[in] interpolation		前回の更新から次の更新までの割合
+		 **************************************************************************************************** */
+		void SetInterpolation(const double interpolation) noexcept
+		{
+			// プレイヤーが動いていない間は補間すると前の場所に引きずられる
+			const bool isMoving = (pFixedUpdate == &Stage::Impl::UpdatePlayerAction);
+
+			for (auto pPlayer : apPlayers)
+			{
+				if (isMoving)
+				{
+					pPlayer->SetInterpolation(interpolation);
+				}
+				else
+				{
+					pPlayer->ResetInterpolation();
+				}
+			}
 		}
 
 		/** ****************************************************************************************************
@@ -94,19 +200,18 @@ namespace MySystem
 			auto transformer = camera.createTransformer();
 			const ScopedRenderStates2D sampler{ SamplerState::ClampNearest };
 
-			(this->*pDraw)();
+			(this->*pDraw)(GetViewRect());
 
 			//FontAsset(U"Stage")(U"Enterキーでやり直し").draw(0.0, 0.0);
 		}
 
 		/** ****************************************************************************************************
-		 * @brief ステージ生成
+		 * @brief				ステージ生成
+		 * @param[in] data		生成用データ
 		 **************************************************************************************************** */
-		void CreateStage() noexcept
+		void CreateStage(const StageData::Desc& data) noexcept
 		{
-			auto data = StageData::GetCurrentData();
-
-			const auto& pieceData = data->aPieceDescs;
+			const auto& pieceData = data.aPieceDescs;
 
 			apGimmicks.clear();
 			apPlayers.clear();
@@ -115,6 +220,13 @@ namespace MySystem
 			apPiece.clear();
 			apPiece.resize(pieceData.size());
 
+			aHitBoxes.clear();
+			aHitBoxLayers.clear();
+			isHitBoxCreated = false;
+			aWorldHitBoxes.clear();
+			groundGrid.Clear();
+			isGroundCreated = false;
+
 			for (size_t i = 0; i < pieceData.size(); i++)
 			{
 				apPiece[i].reset();
@@ -127,6 +239,62 @@ namespace MySystem
 			BitFlag::Pop(flag, _PIECE_ACTION);
 		}
 
+		/** ****************************************************************************************************
+		 * @brief				変更されたカケラだけを作り直す(プレイヤーとカメラはそのまま残す)
+		 * @param[in] oldData	生成に使ったデータ
+		 * @param[in] newData	変更後のデータ
+		 **************************************************************************************************** */
+		void ReloadStage(const StageData::Desc& oldData, const StageData::Desc& newData) noexcept
+		{
+			const auto& aOldDatas = oldData.aPieceDescs;
+			const auto& aNewDatas = newData.aPieceDescs;
+
+			// ギミックは動くうちに他のカケラへ付け替わるので、数や並びが変わったら全て作り直す
+			bool isSameGimmicks = (aOldDatas.size() == aNewDatas.size() && aNewDatas.size() == apPiece.size());
+
+			for (size_t i = 0; isSameGimmicks && i < aNewDatas.size(); ++i)
+			{
+				isSameGimmicks = StagePieceData::IsSameGimmicks(aOldDatas[i], aNewDatas[i]);
+			}
+
+			if (not isSameGimmicks)
+			{
+				CreateStage(newData);
+				return;
+			}
+
+			bool isChanged = false;
+
+			for (size_t i = 0; i < aNewDatas.size(); ++i)
+			{
+				if (StagePieceData::IsSameBack(aOldDatas[i], aNewDatas[i]) &&
+					StagePieceData::IsSameTiles(aOldDatas[i], aNewDatas[i]))
+				{
+					continue;
+				}
+
+				apPiece[i]->Reload(aOldDatas[i], aNewDatas[i]);
+
+				// 作り直したカケラから上の層だけ合成し直す
+				if (i < aHitBoxLayers.size())
+				{
+					aHitBoxLayers[i].isValid = false;
+				}
+
+				isChanged = true;
+			}
+
+			if (not isChanged)
+			{
+				return;
+			}
+
+			isHitBoxCreated = false;
+			InvalidateGround();
+
+			CreateHitBox();
+		}
+
 		/** ****************************************************************************************************
 		 * @brief ゲームクリアにする
 		 **************************************************************************************************** */
@@ -153,6 +321,26 @@ namespace MySystem
 			BitFlag::Pop(flag, _FALL_OUT);
 		}
 
+		/** ****************************************************************************************************
+		 * @brief ワールド座標の当たり判定を作り直すようにする
+		 **************************************************************************************************** */
+		void InvalidateGround()
+		{
+			isGroundCreated = false;
+		}
+
+		/** ****************************************************************************************************
+		 * @brief 当たり判定を合成済みの層を使わずに最初から作り直す
+		 **************************************************************************************************** */
+		void RebuildHitBox()
+		{
+			aHitBoxLayers.clear();
+			isHitBoxCreated = false;
+			InvalidateGround();
+
+			CreateHitBox();
+		}
+
 		/** ****************************************************************************************************
 		 * @brief			ステージ読み込み待ちか確認
 		 * @retval true		待っている
@@ -173,33 +361,45 @@ namespace MySystem
 			return BitFlag::CheckAnyPop(flag, _LOAD_WAIT_SELECT);
 		}
 
-	private:
 		/** ****************************************************************************************************
-		 * @brief プレイヤーの行動ターン更新
+		 * @brief			ゲームクリアかゲームオーバーになったか確認
+		 * @retval true		なった
+		 * @retval false	なっていない
 		 **************************************************************************************************** */
-		void UpdatePlayerAction()
+		bool IsGameEnd() const noexcept
 		{
-			Array<LineString> groundLines;
+			return BitFlag::CheckAnyPop(flag, _MASK_GAME_END);
+		}
 
-			for (auto hitBox : aHitBoxes)
-			{
-				auto worldHitBox = hitBox.
-					rotate(transform.GetWorldAngle()).
-					scale(transform.GetWorldScale()).
-					moveBy(transform.GetWorldPosition());
+	private:
+		/** ****************************************************************************************************
+		 * @brief				カーソルをカメラから見たワールド座標に直した入力を取得
+		 * @param[in] input		入力の状態
+		 * @return				カーソルをワールド座標に直した入力の状態
+		 **************************************************************************************************** */
+		InputData::State ToWorldInput(const InputData::State& input) const
+		{
+			auto worldInput = input;
 
-				groundLines.emplace_back(LineString{ worldHitBox.outer() });
+			worldInput.cursorPosition = camera.getInvMat3x2().transformPoint(input.cursorPosition);
 
-				for (auto inner : worldHitBox.inners())
-				{
-					groundLines.emplace_back(LineString{ inner });
-				}
-			}
+			return worldInput;
+		}
 
+		/** ****************************************************************************************************
+		 * @brief					プレイヤーの行動ターン更新
+		 * @param[in] deltaTime		1回の更新で進める時間
+		 * @param[in] input			入力の状態
+		 **************************************************************************************************** */
+		void UpdatePlayerAction(const double deltaTime, const InputData::State& input)
+		{
 			Array<std::weak_ptr<GimmickData::Gimmick>> apAllGimmicks;
 
 			apAllGimmicks.insert(apAllGimmicks.end(), apGoals.begin(), apGoals.end());
 
+			// 地面は動かないので、ステージ自体が動いたときだけ作り直す
+			UpdateGround();
+
 			for (auto player : apPlayers)
 			{
 				if (not player->GetIsActive())
@@ -207,9 +407,9 @@ namespace MySystem
 					continue;
 				}
 
-				player->Update();
+				player->Update(deltaTime, input);
 
-				player->HitCheck(groundLines, apAllGimmicks);
+				player->HitCheck(groundGrid, apAllGimmicks);
 
 				for (auto itr = apPiece.rbegin(); itr != apPiece.rend(); ++itr)
 				{
@@ -253,18 +453,38 @@ namespace MySystem
 		}
 
 		/** ****************************************************************************************************
-		 * @brief プレイヤーの行動ターン描画
+		 * @brief	現在の変換で画面に映る範囲を取得(描画先の四隅を逆変換した外接矩形)
+		 * @return	画面に映る範囲(ワールド座標)
 		 **************************************************************************************************** */
-		void DrawPlayerAction() const
+		static RectF GetViewRect()
+		{
+			const auto inverse = (Graphics2D::GetLocalTransform() * Graphics2D::GetCameraTransform()).inverse();
+			const RectF target{ Vec2::Zero(), Graphics2D::GetRenderTargetSize() };
+
+			return Quad{
+				inverse.transformPoint(target.tl()),
+				inverse.transformPoint(target.tr()),
+				inverse.transformPoint(target.br()),
+				inverse.transformPoint(target.bl()) }.boundingRect();
+		}
+
+		/** ****************************************************************************************************
+		 * @brief				プレイヤーの行動ターン描画
+		 * @param[in] viewRect	画面に映る範囲(ワールド座標)
+		 **************************************************************************************************** */
+		void DrawPlayerAction(const RectF& viewRect) const
 		{
 			for (auto itr = apGimmicks.begin(); itr != apGimmicks.end(); ++itr)
 			{
-				(*itr)->Draw();
+				if ((*itr)->IsVisible(viewRect))
+				{
+					(*itr)->Draw();
+				}
 			}
 
 			for (auto itr = apPiece.begin(); itr != apPiece.end(); ++itr)
 			{
-				(*itr)->Draw();
+				(*itr)->Draw(viewRect);
 			}
 
 			Array<std::weak_ptr<GimmickData::Gimmick>> apAllGimmicks;
@@ -276,7 +496,7 @@ namespace MySystem
 			{
 				auto pGimmick = itr->lock();
 
-				if (not pGimmick->GetIsActive())
+				if (not pGimmick->GetIsActive() || not pGimmick->IsVisible(viewRect))
 				{
 					continue;
 				}
@@ -286,15 +506,23 @@ namespace MySystem
 		}
 
 		/** ****************************************************************************************************
-		 * @brief カケラの操作ターン更新
+		 * @brief				カケラの操作ターン更新
+		 * @param[in] input		入力の状態(カーソルはワールド座標)
 		 **************************************************************************************************** */
-		void UpdatePieceAction()
+		void UpdatePieceAction(const InputData::State& input)
 		{
 			// 後から描画したものが先にヒットするものとする
 			for (auto itr = apPiece.rbegin(); itr != apPiece.rend(); ++itr)
 			{
+				const bool isAction = (*itr)->UpdatePiece(input);
+
+				if ((*itr)->GetCursorStyle() != CursorStyle::Default)
+				{
+					cursorStyle = (*itr)->GetCursorStyle();
+				}
+
 				// 現在操作中でないなら次へ
-				if (not (*itr)->UpdatePiece())
+				if (not isAction)
 				{
 					continue;
 				}
@@ -313,26 +541,29 @@ namespace MySystem
 		}
 
 		/** ****************************************************************************************************
-		 * @brief カケラの操作ターン描画
+		 * @brief				カケラの操作ターン描画
+		 * @param[in] viewRect	画面に映る範囲(ワールド座標)
 		 **************************************************************************************************** */
-		void DrawPieceAction() const
+		void DrawPieceAction(const RectF& viewRect) const
 		{
 			for (auto itr = apPiece.begin(); itr != apPiece.end(); ++itr)
 			{
-				(*itr)->Draw();
+				(*itr)->Draw(viewRect);
 			}
 		}
 
 		/** ****************************************************************************************************
-		 * @brief ゲームクリア時更新
+		 * @brief					ゲームクリア時更新
+		 * @param[in] deltaTime		1回の更新で進める時間
+		 * @param[in] input			入力の状態
 		 **************************************************************************************************** */
-		void UpdateGameClear()
+		void UpdateGameClear(const double deltaTime, const InputData::State& input)
 		{
 			const double CAMERA_TIME = 0.5;
 			const double CLEAR_WAIT = 1.0;
 			const double CAMERA_SCALE = 3.0;
 
-			animationTime += Scene::DeltaTime();
+			animationTime += deltaTime;
 
 			if (animationTime < CAMERA_TIME)
 			{
@@ -356,26 +587,29 @@ namespace MySystem
 		}
 
 		/** ****************************************************************************************************
-		 * @brief ゲームクリア時描画
+		 * @brief				ゲームクリア時描画
+		 * @param[in] viewRect	画面に映る範囲(ワールド座標)
 		 **************************************************************************************************** */
-		void DrawGameClear() const
+		void DrawGameClear(const RectF& viewRect) const
 		{
-			DrawPlayerAction();
+			DrawPlayerAction(viewRect);
 		}
 
 		/** ****************************************************************************************************
-		 * @brief ゲームオーバー時更新
+		 * @brief					ゲームオーバー時更新
+		 * @param[in] deltaTime		1回の更新で進める時間
+		 * @param[in] input			入力の状態
 		 **************************************************************************************************** */
-		void UpdateGameOver()
+		void UpdateGameOver(const double deltaTime, const InputData::State& input)
 		{
 			const double CAMERA_TIME = 0.5;
 
-			animationTime += Scene::DeltaTime();
+			animationTime += deltaTime;
 
 			if (animationTime < CAMERA_TIME)
 			{
 				auto position = transform.GetWorldPosition();
-				position.x += Periodic::Triangle0_1(CAMERA_TIME / 5.0) * 5.0;
+				position.x += Periodic::Triangle0_1(CAMERA_TIME / 5.0, animationTime) * 5.0;
 
 				camera.setCenter(position);
 			}
@@ -386,23 +620,25 @@ namespace MySystem
 		}
 
 		/** ****************************************************************************************************
-		 * @brief ゲームオーバー時描画
+		 * @brief				ゲームオーバー時描画
+		 * @param[in] viewRect	画面に映る範囲(ワールド座標)
 		 **************************************************************************************************** */
-		void DrawGameOver() const
+		void DrawGameOver(const RectF& viewRect) const
 		{
-			DrawPlayerAction();
+			DrawPlayerAction(viewRect);
 		}
 
 		/** ****************************************************************************************************
-		 * @brief 更新・描画の切り替え
+		 * @brief				更新・描画の切り替え
+		 * @param[in] input		入力の状態
 		 **************************************************************************************************** */
-		void ChangeMode()
+		void ChangeMode(const InputData::State& input)
 		{
 			// 全てのフラグがたっていないなら -> ゲーム続行時の処理へ
 			if (BitFlag::CheckAllUnPop(flag, _MASK_GAME_END))
 			{
 				// キーかマウスを入力したときに切り替えるが、キーに比べ余計な行動を生みにくいのでマウス操作の方が優先される。
-				if (CommonKeyState::gINPUT_ANY_MOUSE.pressed())
+				if (input.isAnyMousePressed)
 				{
 					if (BitFlag::CheckAllUnPop(flag, _PIECE_ACTION))
 					{
@@ -411,7 +647,7 @@ namespace MySystem
 
 					BitFlag::Pop(flag, _PIECE_ACTION);
 				}
-				else if (CommonKeyState::gINPUT_ANY_KEY.pressed())
+				else if (input.isAnyKeyPressed)
 				{
 					if (BitFlag::CheckAnyPop(flag, _PIECE_ACTION))
 					{
@@ -435,11 +671,13 @@ namespace MySystem
 				if (BitFlag::CheckAnyPop(flag, _PIECE_ACTION))
 				{
 					pUpdate = &Stage::Impl::UpdatePieceAction;
+					pFixedUpdate = nullptr;
 					pDraw = &Stage::Impl::DrawPieceAction;
 				}
 				else // プレイヤー操作モード確定 
 				{
-					pUpdate = &Stage::Impl::UpdatePlayerAction;
+					pUpdate = nullptr;
+					pFixedUpdate = &Stage::Impl::UpdatePlayerAction;
 					pDraw = &Stage::Impl::DrawPlayerAction;
 				}
 			}
@@ -448,7 +686,8 @@ namespace MySystem
 				// フラグが立っている -> ゲームクリア確定
 				if (BitFlag::CheckAnyPop(flag, _CLEAR))
 				{
-					pUpdate = &Stage::Impl::UpdateGameClear;
+					pUpdate = nullptr;
+					pFixedUpdate = &Stage::Impl::UpdateGameClear;
 					pDraw = &Stage::Impl::DrawGameClear;
 				}
 				else // ゲームオーバーの可能性あり
@@ -459,11 +698,12 @@ namespace MySystem
 						BitFlag::UnPop(flag, _GAME_OVER);
 
 						// やり直し
-						ChangeMode();
+						ChangeMode(input);
 						return;
 					}
 
-					pUpdate = &Stage::Impl::UpdateGameOver;
+					pUpdate = nullptr;
+					pFixedUpdate = &Stage::Impl::UpdateGameOver;
 					pDraw = &Stage::Impl::DrawGameOver;
 				}
 			}
@@ -474,73 +714,121 @@ namespace MySystem
 		 **************************************************************************************************** */
 		void CreateHitBox()
 		{
-			aHitBoxes.clear();
+			// カケラの数が変わっていたら今までの層は使えない
+			if (aHitBoxLayers.size() != apPiece.size())
+			{
+				aHitBoxLayers.clear();
+				aHitBoxLayers.resize(apPiece.size());
+			}
 
-			for (auto piece = apPiece.begin(); piece != apPiece.end(); ++piece)
+			// 動かされたカケラのうち一番下の層を探す(それより下の層は合成結果をそのまま使える)
+			size_t startIndex = apPiece.size();
+			for (size_t i = 0, max = apPiece.size(); i < max; ++i)
 			{
-				auto pieceHitBoxes = (*piece)->GetLocalHitBoxes();
+				if (not aHitBoxLayers[i].IsSameBody(apPiece[i]->GetLocalBody()))
+				{
+					startIndex = i;
+					break;
+				}
+			}
+
+			// どのカケラも動いていないなら作り直す必要はない
+			if (startIndex == apPiece.size() && isHitBoxCreated)
+			{
+				return;
+			}
+
+			for (size_t i = startIndex, max = apPiece.size(); i < max; ++i)
+			{
+				auto& rLayer = aHitBoxLayers[i];
+				const auto& piece = apPiece[i];
+				const auto body = piece->GetLocalBody();
+
+				// 自身が動いたカケラだけ寄与分を作り直す
+				if (not rLayer.IsSameBody(body))
+				{
+					rLayer.isValid = true;
+					rLayer.body = body;
+					rLayer.backBox = body.asPolygon();
+					rLayer.aPieceHitBoxes = piece->GetLocalHitBoxes();
+				}
+
+				static const Array<Polygon> EMPTY;
+				const auto& aUnderHitBoxes = (i == 0) ? EMPTY : aHitBoxLayers[i - 1].aHitBoxes;
+				const auto& pieceHitBoxes = rLayer.aPieceHitBoxes;
 				Array<Polygon> temp;
 
-				if ((*piece)->GetType() == StagePieceData::Type::Void)
+				if (piece->GetType() == StagePieceData::Type::Void)
 				{
 					// 元々当たり判定があったならそのまま
-					if (not aHitBoxes.empty())
-					{
-						temp.insert(temp.end(), aHitBoxes.begin(), aHitBoxes.end());
-					}
-
-					// カケラに当たり判定があったならそのまま
-					if (not pieceHitBoxes.empty())
+					if (not aUnderHitBoxes.empty())
 					{
-						temp.insert(temp.end(), pieceHitBoxes.begin(), pieceHitBoxes.end());
+						temp.insert(temp.end(), aUnderHitBoxes.begin(), aUnderHitBoxes.end());
 					}
 				}
 				else
 				{
-					auto backBox = (*piece)->GetLocalBody().asPolygon();
-					for (auto hitBox : aHitBoxes)
+					for (const auto& hitBox : aUnderHitBoxes)
 					{
-						auto results = Geometry2D::Subtract(hitBox, backBox);
+						auto results = Geometry2D::Subtract(hitBox, rLayer.backBox);
 
 						temp.insert(temp.end(), results.begin(), results.end());
 					}
 				}
 
-				// 今までのコリジョンと合成を試みる
-				for (auto collision : pieceHitBoxes)
-				{
-					while (true)
-					{
-						bool isFusion = false;
+				// 今までのコリジョンとまとめて合成する
+				temp.insert(temp.end(), pieceHitBoxes.begin(), pieceHitBoxes.end());
 
-						for (auto itr = temp.begin(); itr != temp.end(); ++itr)
-						{
-							auto collisions = Geometry2D::Or(*itr, collision);
+				rLayer.aHitBoxes = TileData::CreateUnion(temp);
+			}
 
-							// 2つが1つになったときのみ合成成功とする
-							if (collisions.size() == 1) {
-								collision = collisions[0];
+			aHitBoxes = aHitBoxLayers.empty() ? Array<Polygon>{} : aHitBoxLayers.back().aHitBoxes;
 
-								// 合成されたということはオリジナルは消えることになる
-								temp.erase(itr);
+			TileData::GetSimplePolygon(aHitBoxes, 0.0, 0.00001);
 
-								isFusion = true;
-								break;
-							}
-						}
+			isHitBoxCreated = true;
 
-						// これ以上合成出来ないことが判明した
-						if (not isFusion) {
-							temp << collision;
-							break;
-						}
-					}
-				}
+			CreateGround();
+		}
 
-				aHitBoxes = temp;
+		/** ****************************************************************************************************
+		 * @brief ステージが動いていたらワールド座標の当たり判定を作り直す
+		 **************************************************************************************************** */
+		void UpdateGround()
+		{
+			if (isGroundCreated &&
+				groundPosition == transform.GetWorldPosition() &&
+				groundScale == transform.GetWorldScale() &&
+				groundAngle == transform.GetWorldAngle())
+			{
+				return;
 			}
 
-			TileData::GetSimplePolygon(aHitBoxes, 0.0, 0.00001);
+			CreateGround();
+		}
+
+		/** ****************************************************************************************************
+		 * @brief ワールド座標の当たり判定と地面の線分の空間分割を生成
+		 **************************************************************************************************** */
+		void CreateGround()
+		{
+			groundPosition = transform.GetWorldPosition();
+			groundScale = transform.GetWorldScale();
+			groundAngle = transform.GetWorldAngle();
+
+			aWorldHitBoxes = aHitBoxes;
+
+			for (auto& hitBox : aWorldHitBoxes)
+			{
+				hitBox.
+					rotate(groundAngle).
+					scale(groundScale).
+					moveBy(groundPosition);
+			}
+
+			groundGrid.Create(aWorldHitBoxes);
+
+			isGroundCreated = true;
 		}
 
 		/** ****************************************************************************************************
@@ -589,15 +877,7 @@ namespace MySystem
 		 **************************************************************************************************** */
 		void CheckActiveGimmick()
 		{
-			Array<Polygon> aWorldHitBoxes{ aHitBoxes };
-
-			for (auto& hitBox : aWorldHitBoxes)
-			{
-				hitBox.
-					rotate(transform.GetWorldAngle()).
-					scale(transform.GetWorldScale()).
-					moveBy(transform.GetWorldPosition());
-			}
+			UpdateGround();
 
 			for (auto itr = apGimmicks.begin(); itr != apGimmicks.end();)
 			{
@@ -633,7 +913,7 @@ namespace MySystem
 
 					pGimmick->SetIsActive(true);
 
-					for (auto hitBox : aWorldHitBoxes)
+					for (const auto& hitBox : aWorldHitBoxes)
 					{
 						if (hitBox.intersects(collision))
 						{
@@ -664,9 +944,32 @@ namespace MySystem
 
 	Stage::~Stage() = default;
 
-	void Stage::Update() noexcept
+	void Stage::RegisterAssets()
 	{
-		_pImpl->Update();
+		FontAsset::Register(U"Stage", 30);
+		GimmickData::RegisterTextures();
+		StagePiece::RegisterTextures();
+		Tile::RegisterTextures();
+	}
+
+	void Stage::Update(const InputData::State& input) noexcept
+	{
+		_pImpl->Update(input);
+	}
+
+	void Stage::FixedUpdate(const double deltaTime, const InputData::State& input) noexcept
+	{
+		_pImpl->FixedUpdate(deltaTime, input);
+	}
+
+	CursorStyle Stage::GetCursorStyle() const noexcept
+	{
+		return _pImpl->cursorStyle;
+	}
+
+	void Stage::SetInterpolation(const double interpolation) noexcept
+	{
+		_pImpl->SetInterpolation(interpolation);
 	}
 
 	void Stage::Draw() const noexcept
@@ -676,14 +979,24 @@ namespace MySystem
 
 	void Stage::CreateStage() noexcept
 	{
-		_pImpl->CreateStage();
+		_pImpl->CreateStage(*StageData::GetCurrentData());
 	}
 
 	void Stage::CreateStage(const StageData::WorldIndex worldIndex, const StageData::StageIndex stageIndex) noexcept
 	{
 		StageData::Load(worldIndex, stageIndex);
 
-		_pImpl->CreateStage();
+		_pImpl->CreateStage(*StageData::GetCurrentData());
+	}
+
+	void Stage::CreateStage(const StageData::Desc& data) noexcept
+	{
+		_pImpl->CreateStage(data);
+	}
+
+	void Stage::ReloadStage(const StageData::Desc& oldData, const StageData::Desc& newData) noexcept
+	{
+		_pImpl->ReloadStage(oldData, newData);
 	}
 
 	void Stage::SetGameClear()
@@ -711,6 +1024,11 @@ namespace MySystem
 		return _pImpl->LoadSelectWait();
 	}
 
+	bool Stage::IsGameEnd() const noexcept
+	{
+		return _pImpl->IsGameEnd();
+	}
+
 	std::weak_ptr<GimmickData::Gimmick> Stage::CreatePlayer(const GimmickData::Desc& data, Transform* pParent)
 	{
 		auto pointer = _pImpl->apPlayers.emplace_back(new Player{ data, pParent });
@@ -728,5 +1046,11 @@ namespace MySystem
 	void Stage::SetLocalScale(const Vec2& scale) noexcept
 	{
 		_pImpl->transform.SetLocalScale(scale);
+		_pImpl->InvalidateGround();
+	}
+
+	void Stage::RebuildHitBox() noexcept
+	{
+		_pImpl->RebuildHitBox();
 	}
 }
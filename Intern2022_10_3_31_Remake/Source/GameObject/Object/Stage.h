@@ -7,6 +7,7 @@
 #include <Siv3D.hpp>
 #include "../Data/StageData.h"
 #include "../Data/GimmickData.h"
+#include "../Data/InputData.h"
 
 namespace MySystem
 {
@@ -39,9 +40,34 @@ namespace MySystem
 		~Stage();
 
 		/** ****************************************************************************************************
-		 * @brief 更新
+		 * @brief ステージの描画で使うアセットを登録(描画する側で一度だけ呼ぶ、描画しないなら不要)
 		 **************************************************************************************************** */
-		void Update() noexcept;
+		static void RegisterAssets();
+
+		/** ****************************************************************************************************
+		 * @brief				更新
+		 * @param[in] input		入力の状態
+		 **************************************************************************************************** */
+		void Update(const InputData::State& input) noexcept;
+
+		/** ****************************************************************************************************
+		 * @brief					固定時間での更新(1フレームに何回呼んでもよい)
+		 * @param[in] deltaTime		1回の更新で進める時間
+		 * @param[in] input			入力の状態
+		 **************************************************************************************************** */
+		void FixedUpdate(const double deltaTime, const InputData::State& input) noexcept;
+
+		/** ****************************************************************************************************
+		 * @brief	前回の更新でカーソルが指していた操作に合うカーソルの形を取得
+		 * @return	カーソルの形(何も指していなければ Default)
+		 **************************************************************************************************** */
+		CursorStyle GetCursorStyle() const noexcept;
+
+		/** ****************************************************************************************************
+		 * @brief						描画時の補間割合を設定
+		 * @param[in] interpolation		前回の更新から次の更新までの割合
+		 **************************************************************************************************** */
+		void SetInterpolation(const double interpolation) noexcept;
 
 		/** ****************************************************************************************************
 		 * @brief 描画
@@ -60,6 +86,19 @@ namespace MySystem
 		 **************************************************************************************************** */
 		void CreateStage(const StageData::WorldIndex worldIndex, const StageData::StageIndex stageIndex) noexcept;
 
+		/** ****************************************************************************************************
+		 * @brief				ステージ生成(現在のデータを変えないので別スレッドで生成中のステージにも使える)
+		 * @param[in] data		生成用データ
+		 **************************************************************************************************** */
+		void CreateStage(const StageData::Desc& data) noexcept;
+
+		/** ****************************************************************************************************
+		 * @brief				変更されたカケラだけを作り直す(ギミックが変わった場合はステージごと作り直す)
+		 * @param[in] oldData	生成に使ったデータ
+		 * @param[in] newData	変更後のデータ
+		 **************************************************************************************************** */
+		void ReloadStage(const StageData::Desc& oldData, const StageData::Desc& newData) noexcept;
+
 		/** ****************************************************************************************************
 		 * @brief ゲームクリアにする
 		 **************************************************************************************************** */
@@ -89,6 +128,13 @@ namespace MySystem
 		 **************************************************************************************************** */
 		bool LoadSelectWait();
 
+		/** ****************************************************************************************************
+		 * @brief			ゲームクリアかゲームオーバーになったか確認
+		 * @retval true		なった
+		 * @retval false	なっていない
+		 **************************************************************************************************** */
+		bool IsGameEnd() const noexcept;
+
 		/** ****************************************************************************************************
 		 * @brief				プレイヤー生成
 		 * @oaram[in] data		生成用データ
@@ -110,6 +156,11 @@ namespace MySystem
 		 * @param[in] scale	新しい大きさ
 		 **************************************************************************************************** */
 		void SetLocalScale(const Vec2& scale) noexcept;
+
+		/** ****************************************************************************************************
+		 * @brief 当たり判定を合成済みの層を使わずに最初から作り直す
+		 **************************************************************************************************** */
+		void RebuildHitBox() noexcept;
 	};
 }
 
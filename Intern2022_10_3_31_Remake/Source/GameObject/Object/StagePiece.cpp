@@ -4,10 +4,9 @@
  **************************************************************************************************** */
 #include "StagePiece.h"
 #include "Stage.h"
+#include "Tile.h"
 #include "../Data/Transform.h"
 #include "../../Utility/BitFlag.h"
-#include "../../Utility/CommonKey.h"
-#include "Tile.h"
 
 namespace MySystem
 {
@@ -25,21 +24,35 @@ namespace MySystem
 		static constexpr _Flag _NOW_ACTIVE = BitFlag::Get<_Flag>(6);	//!< 選択中か
 		static constexpr _Flag _MASK_NOW_ACTION = BitFlag::GetMask<_Flag>(_NOW_MOVING, _NOW_SCALING, _NOW_ROLLING);	//!< 何か作業中か
 
+		static constexpr double _TILE_STRETCH = 1.0;	//!< タイル同士の隙間が見えないように広げる幅
+		static constexpr int32 _MAX_CACHE_SIZE = 2048;	//!< 描画結果を残すテクスチャの最大の辺の長さ
+		static constexpr double _MIN_CACHE_RESOLUTION = 1.0 / 16.0;	//!< 描画結果を残す最低の解像度(縮みきる途中で描き直し続けないようにする)
+		static constexpr double _FRAME_THICKNESS = 5.0;	//!< 選択中の枠の太さ
+		static constexpr double _CULL_TILE_MARGIN = TileData::gTILE_SIZE * 1.5;	//!< タイルの位置から見た目の端までの最大の距離(回転しても収まる長さ)
+
 		//! 各種テクスチャのラベルとパス
 		static const std::array<std::pair<String, String>, static_cast<StagePieceData::TypeIndex>(StagePieceData::Type::Max) + 1> _TEXTURE_LABELS;
 
+		//! 種類ごとの解決済みのテクスチャ(描画のたびにラベルで引かないように登録時に解決する)
+		static std::array<Texture, static_cast<StagePieceData::TypeIndex>(StagePieceData::Type::Max) + 1> _aTextures;
+
 	public:
 		Transform	transform;			//!< 座標
 		Vec2		backScale;			//!< 背景サイズ
 		Vec2		prevCursorPos;		//!< 前回のカーソル位置
 		double		prevScale;			//!< 前回の大きさ
 		double		cursorDistance;		//!< カーソルの距離
+		CursorStyle	cursorStyle;		//!< カーソルが指している操作に合うカーソルの形
 		StagePieceData::TypeIndex type;	//!< 背景の種類
 		_Flag		flag;				//!< フラグ群
 		Stage* pStage;					//!< ステージのポインタ
 		uint8		pieceNumber;		//!< カケラの格納場所
-		Array<std::unique_ptr<Tile>>	apTiles;				//!< タイル群
+		Buffer2D						tileMesh;				//!< カケラ内の座標でのタイルの頂点群(タイルが変わった時だけ作り直す)
+		Array<uint32>					aTileRowStarts;			//!< 行ごとの最初の三角形の番号(末尾は三角形の数)
+		TileData::GridIndex				tileFirstRow;			//!< aTileRowStarts の先頭の行
 		Array<Polygon>					aHitBoxes;				//!< タイルの当たり判定
+		mutable RenderTexture			cache;					//!< 背景とタイルをカケラ内の座標で描いておくテクスチャ
+		mutable double					cacheResolution;		//!< キャッシュを描いた解像度(画面上の拡大率を 2 の累乗に切り上げたもの、0 なら描き直す)
 		Array<std::weak_ptr<GimmickData::Gimmick>>	apGimmick;	//!< カケラに所属するギミック
 
 		/** ****************************************************************************************************
@@ -55,22 +68,36 @@ namespace MySystem
 			prevScale{ 0.0 },
 			prevCursorPos{ 0.0, 0.0 },
 			cursorDistance{ 0.0 },
+			cursorStyle{ CursorStyle::Default },
 			type{ data.backType },
 			flag{ static_cast<_Flag>(0) },
 			pStage{ pStage },
-			pieceNumber{ pieceNumber }
+			pieceNumber{ pieceNumber },
+			tileFirstRow{ 0 },
+			cacheResolution{ 0.0 }
 		{
 			BitFlag::PopOrUnPop(flag, _CAN_MOVING, data.canMoving);
 			BitFlag::PopOrUnPop(flag, _CAN_SCALING, data.canScaling);
 			BitFlag::PopOrUnPop(flag, _CAN_ROLLING, data.canRolling);
 
+			CreateTile(data);
+			CreateGimmick(data.aGimmiclDesc);
+		}
+
+		/** ****************************************************************************************************
+		 * @brief テクスチャを登録
+		 **************************************************************************************************** */
+		static void RegisterTextures()
+		{
 			for (auto label : _TEXTURE_LABELS)
 			{
 				TextureAsset::Register(label.first, label.second, TextureDesc::Mipped);
 			}
 
-			CreateTile(data.aTileDescs);
-			CreateGimmick(data.aGimmiclDesc);
+			for (size_t i = 0; i < _aTextures.size(); ++i)
+			{
+				_aTextures[i] = TextureAsset(_TEXTURE_LABELS[i].first);
+			}
 		}
 
 		/** ****************************************************************************************************
@@ -100,96 +127,198 @@ namespace MySystem
 
 		/** ****************************************************************************************************
 		 * @brief					タイル生成
-		 * @oaram[in] aGimmickDatas	生成用データ
+		 * @oaram[in] data			生成用データ
 		 **************************************************************************************************** */
-		void CreateTile(const Array<TileData::Desc>& aTileDatas)
+		void CreateTile(const StagePieceData::Desc& data)
 		{
-			apTiles.clear();
+			const auto& aTileDatas = data.aTileDescs;
+
 			aHitBoxes.clear();
 
-			// 最大でデータの数分出来る
-			apTiles.reserve(aTileDatas.size());
-			aHitBoxes.reserve(aTileDatas.size());
+			tileMesh = CreateTileMesh(aTileDatas, aTileRowStarts, tileFirstRow);
+			cacheResolution = 0.0;
 
-			for (auto& desc : aTileDatas)
+			// 事前に合成した当たり判定がタイルの並びと一致していればそのまま使う
+			if (data.bakedHash != 0 && data.bakedHash == TileData::CalcuHitBoxHash(aTileDatas))
 			{
-				auto& tile = apTiles.emplace_back(std::make_unique<Tile>(desc, &transform));
+				aHitBoxes = data.aBakedHitBoxes;
+				return;
+			}
+
+			aHitBoxes = TileData::CreateHitBoxes(aTileDatas);
+		}
 
-				auto collision = tile->GetLocalHitBox();
+		/** ****************************************************************************************************
+		 * @brief					全てのタイルをカケラ内の座標で1つの頂点群にまとめる(上の行から順に並べる)
+		 * @param[in] aTileDatas	タイルのデータ群
+		 * @param[out] aRowStarts	行ごとの最初の三角形の番号(末尾は三角形の数)
+		 * @param[out] rFirstRow	aRowStarts の先頭の行
+		 * @return					頂点群
+		 **************************************************************************************************** */
+		static Buffer2D CreateTileMesh(const Array<TileData::Desc>& aTileDatas, Array<uint32>& aRowStarts, TileData::GridIndex& rFirstRow)
+		{
+			// 広げる前の 1 マス分の四隅(左上、右上、右下、左下)
+			static constexpr double STRETCH = _TILE_STRETCH / TileData::gTILE_SIZE;
+			static constexpr std::array<Vec2, 4> CORNERS = {
+				Vec2{ -STRETCH, -STRETCH },
+				Vec2{ 1.0 + STRETCH, -STRETCH },
+				Vec2{ 1.0 + STRETCH, 1.0 + STRETCH },
+				Vec2{ -STRETCH, 1.0 + STRETCH }
+			};
+			static constexpr std::array<Point, 4> UV_CORNERS = {
+				Point{ 0, 0 },
+				Point{ 1, 0 },
+				Point{ 1, 1 },
+				Point{ 0, 1 }
+			};
+
+			const Float2 uvCellSize{ 1.0f / TileData::gUV_CELL_NUM.x, 1.0f / TileData::gUV_CELL_NUM.y };
+
+			// 画面に映る行の範囲だけを続けて描けるように、行の順に並べ替える
+			Array<TileData::Desc> aSorted{ aTileDatas };
+			std::stable_sort(aSorted.begin(), aSorted.end(),
+				[](const TileData::Desc& a, const TileData::Desc& b) { return a.y < b.y; });
+
+			Buffer2D mesh;
+			mesh.vertices.reserve(aSorted.size() * CORNERS.size());
+			mesh.indices.reserve(aSorted.size() * 2);
+
+			for (const auto& desc : aSorted)
+			{
+				const auto position = desc.GetPosition();
+				const auto angle = desc.GetAngle();
+				const auto uv = desc.GetUV();
+				const auto index = static_cast<Vertex2D::IndexType>(mesh.vertices.size());
 
-				// 今までのコリジョンと合成を試みる
-				while (true)
+				for (size_t i = 0; i < CORNERS.size(); ++i)
 				{
-					bool isFusion = false;
+					const auto corner = CORNERS[i].rotated(angle) * TileData::gTILE_SIZE + position;
 
-					for (auto itr = aHitBoxes.begin(); itr != aHitBoxes.end(); ++itr)
-					{
-						auto collisions = Geometry2D::Or(*itr, collision);
+					auto& rVertex = mesh.vertices.emplace_back();
+					rVertex.pos = Float2{ static_cast<float>(corner.x), static_cast<float>(corner.y) };
+					rVertex.tex = Float2{ (uv.x + UV_CORNERS[i].x) * uvCellSize.x, (uv.y + UV_CORNERS[i].y) * uvCellSize.y };
+					rVertex.color = Float4{ 1.0f, 1.0f, 1.0f, 1.0f };
+				}
 
-						// 2つが1つになったときのみ合成成功とする
-						if (collisions.size() == 1) {
-							collision = collisions[0];
+				mesh.indices.push_back(TriangleIndex{ index, static_cast<Vertex2D::IndexType>(index + 1), static_cast<Vertex2D::IndexType>(index + 2) });
+				mesh.indices.push_back(TriangleIndex{ index, static_cast<Vertex2D::IndexType>(index + 2), static_cast<Vertex2D::IndexType>(index + 3) });
+			}
 
-							// 合成されたということはオリジナルは消えることになる
-							aHitBoxes.erase(itr);
+			aRowStarts.clear();
+			rFirstRow = 0;
 
-							isFusion = true;
-							break;
-						}
-					}
+			if (aSorted.isEmpty())
+			{
+				return mesh;
+			}
 
-					// これ以上合成出来ないことが判明した
-					if (not isFusion) {
-						aHitBoxes.emplace_back(collision);
-						break;
-					}
+			rFirstRow = aSorted.front().y;
+			aRowStarts.resize(static_cast<size_t>(aSorted.back().y - rFirstRow) + 2);
+
+			size_t tileIndex = 0;
+
+			for (size_t row = 0; row < aRowStarts.size(); ++row)
+			{
+				while (tileIndex < aSorted.size() && aSorted[tileIndex].y < rFirstRow + static_cast<int32>(row))
+				{
+					++tileIndex;
 				}
+
+				aRowStarts[row] = static_cast<uint32>(tileIndex * 2);
 			}
 
-			TileData::GetSimplePolygon(aHitBoxes, 2.0, 0.00001);
+			return mesh;
 		}
 
 		/** ****************************************************************************************************
-		 * @brief 描画
+		 * @brief					変更されたデータで作り直す(座標とギミックはそのまま残す)
+		 * @param[in] oldData		生成に使ったデータ
+		 * @param[in] newData		変更後のデータ
 		 **************************************************************************************************** */
-		void Draw() const noexcept
+		void Reload(const StagePieceData::Desc& oldData, const StagePieceData::Desc& newData)
 		{
-			auto body = GetBody();
-			auto bodyScale = GetBodyScale();
-			auto texture = TextureAsset(_TEXTURE_LABELS[type].first);
-			ColorF color{ static_cast<double>(StagePieceData::gMAX_PIECE_NUM - pieceNumber - 1) * 0.05 + 0.5 };
-			color.a = 1.0;
+			// 初期配置が変わった時だけ置き直す(プレイヤーが動かした位置は残す)
+			if (not StagePieceData::IsSameBack(oldData, newData))
+			{
+				transform.SetLocalPosition(newData.position);
+				transform.SetLocalScale(Transform::Scale{ newData.scale, newData.scale });
+				transform.SetLocalAngle(newData.angle);
+				backScale = newData.backScale;
+				type = newData.backType;
 
+				BitFlag::PopOrUnPop(flag, _CAN_MOVING, newData.canMoving);
+				BitFlag::PopOrUnPop(flag, _CAN_SCALING, newData.canScaling);
+				BitFlag::PopOrUnPop(flag, _CAN_ROLLING, newData.canRolling);
+
+				cacheResolution = 0.0;
+			}
+
+			if (not StagePieceData::IsSameTiles(oldData, newData))
 			{
-				const ScopedRenderStates2D sampler{ SamplerState::RepeatLinear };
-				body(texture.mapped(bodyScale)).draw(color);
+				CreateTile(newData);
 			}
+		}
+
+		/** ****************************************************************************************************
+		 * @brief				描画
+		 * @param[in] viewRect	画面に映る範囲(ワールド座標)
+		 **************************************************************************************************** */
+		void Draw(const RectF& viewRect) const noexcept
+		{
+			const auto body = GetBody();
 
-			for (auto itr = apGimmick.begin(); itr != apGimmick.end(); ++itr)
+			// 画面に映らないカケラは描かないが、カケラからはみ出したギミックは映ることがあるので個別に確かめる
+			if (not body.boundingRect().stretched(_FRAME_THICKNESS).intersects(viewRect))
 			{
-				(itr)->lock()->Draw();
+				for (const auto& pGimmick : apGimmick)
+				{
+					if (const auto pLocked = pGimmick.lock(); pLocked && pLocked->IsVisible(viewRect))
+					{
+						pLocked->Draw();
+					}
+				}
+
+				return;
 			}
 
-			for (auto itr = apTiles.begin(); itr != apTiles.end(); ++itr)
+			// ギミックは背景とタイルの間に描くので、ギミックを持たず拡大縮小中でもない時だけ描いておいた結果を使う
+			if (apGimmick.empty() && BitFlag::CheckAllUnPop(flag, _NOW_SCALING))
 			{
-				(*itr)->Draw();
+				DrawCache();
+			}
+			else
+			{
+				{
+					const Transformer2D transformer{ GetWorldMatrix() };
+					DrawBack();
+				}
+
+				for (auto itr = apGimmick.begin(); itr != apGimmick.end(); ++itr)
+				{
+					(itr)->lock()->Draw();
+				}
+
+				DrawTiles(viewRect);
 			}
 
 			if (BitFlag::CheckAnyPop(flag, _NOW_ACTIVE))
 			{
-				body.drawFrame(5.0, Palette::Orange);
+				body.drawFrame(_FRAME_THICKNESS, Palette::Orange);
 			}
 		}
 
 		/** ****************************************************************************************************
 		 * @brief			カケラの更新処理
+		 * @param[in] input	入力の状態(カーソルはワールド座標)
 		 * @retval true		アクションがあった
 		 * @retval false	アクションがなかった
 		 **************************************************************************************************** */
-		bool UpdatePiece() noexcept
+		bool UpdatePiece(const InputData::State& input) noexcept
 		{
+			cursorStyle = CursorStyle::Default;
+
 			auto body = GetBody();
-			auto isClicked = CommonKeyState::gINPUT_SUBMIT.down() && body.mouseOver();
+			auto isClicked = input.isSubmitDown && body.intersects(input.cursorPosition);
 
 			if (isClicked)
 			{
@@ -203,11 +332,11 @@ namespace MySystem
 
 			if (BitFlag::CheckAnyPop(flag, _MASK_NOW_ACTION))
 			{
-				return ProcessAction() || isClicked;
+				return ProcessAction(input) || isClicked;
 			}
 			else
 			{
-				return CheckAction(body) || isClicked;
+				return CheckAction(body, input) || isClicked;
 			}
 		}
 
@@ -279,14 +408,128 @@ namespace MySystem
 		}
 
 	private:
+		/** ****************************************************************************************************
+		 * @brief	カケラ内の座標からワールド座標への変換行列の取得
+		 * @return	変換行列
+		 **************************************************************************************************** */
+		Mat3x2 GetWorldMatrix() const
+		{
+			return
+				Mat3x2::Rotate(transform.GetWorldAngle()).
+				scaled(transform.GetWorldScale()).
+				translated(transform.GetWorldPosition());
+		}
+
+		/** ****************************************************************************************************
+		 * @brief 背景をカケラ内の座標で描画
+		 **************************************************************************************************** */
+		void DrawBack() const
+		{
+			const auto& texture = _aTextures[type];
+			ColorF color{ static_cast<double>(StagePieceData::gMAX_PIECE_NUM - pieceNumber - 1) * 0.05 + 0.5 };
+			color.a = 1.0;
+
+			// 模様の細かさは今まで通り画面上の大きさに合わせる
+			const ScopedRenderStates2D sampler{ SamplerState::RepeatLinear };
+			RectF{ Arg::center = Vec2::Zero(), backScale }(texture.mapped(GetBodyScale())).draw(color);
+		}
+
+		/** ****************************************************************************************************
+		 * @brief				画面に映る行のタイルだけをまとめて1回で描画
+		 * @param[in] viewRect	画面に映る範囲(ワールド座標)
+		 **************************************************************************************************** */
+		void DrawTiles(const RectF& viewRect) const
+		{
+			if (aTileRowStarts.isEmpty())
+			{
+				return;
+			}
+
+			// 画面に映る範囲をカケラ内の座標に戻して、その範囲に掛かる行を求める
+			const auto worldMatrix = GetWorldMatrix();
+			const auto inverse = worldMatrix.inverse();
+			const auto localView = Quad{
+				inverse.transformPoint(viewRect.tl()),
+				inverse.transformPoint(viewRect.tr()),
+				inverse.transformPoint(viewRect.br()),
+				inverse.transformPoint(viewRect.bl()) }.boundingRect();
+
+			const auto rowNum = static_cast<int32>(aTileRowStarts.size()) - 1;
+			const auto beginRow = static_cast<int32>(Ceil((localView.y - _CULL_TILE_MARGIN) / TileData::gGRID_SIZE)) - tileFirstRow;
+			const auto endRow = static_cast<int32>(Floor((localView.y + localView.h + _CULL_TILE_MARGIN) / TileData::gGRID_SIZE)) - tileFirstRow + 1;
+			const auto begin = aTileRowStarts[Clamp(beginRow, 0, rowNum)];
+			const auto end = aTileRowStarts[Clamp(endRow, 0, rowNum)];
+
+			if (end <= begin)
+			{
+				return;
+			}
+
+			const Transformer2D transformer{ worldMatrix };
+			tileMesh.draw(begin, end - begin, Tile::GetTexture());
+		}
+
+		/** ****************************************************************************************************
+		 * @brief 描いておいた背景とタイルを1枚の四角形で描画(解像度の段階が変わった時だけ描き直す)
+		 **************************************************************************************************** */
+		void DrawCache() const
+		{
+			// 拡大縮小の演出中に毎フレーム描き直さないよう、解像度は 2 の累乗の段階に切り上げる
+			const double scale = transform.GetWorldScale().x * Graphics2D::GetMaxScaling();
+			const double resolution = Math::Exp2(Ceil(Math::Log2(Max(scale, _MIN_CACHE_RESOLUTION))));
+
+			if (cacheResolution != resolution)
+			{
+				RenderCache(resolution);
+			}
+
+			const Transformer2D transformer{ GetWorldMatrix() };
+			const ScopedRenderStates2D sampler{ SamplerState::ClampLinear };
+
+			RectF{ Arg::center = Vec2::Zero(), backScale }(cache).draw();
+		}
+
+		/** ****************************************************************************************************
+		 * @brief					背景とタイルを画面上の大きさに合わせた解像度でテクスチャに描く
+		 * @param[in] resolution	カケラ内の長さ 1 あたりのピクセル数
+		 **************************************************************************************************** */
+		void RenderCache(const double resolution) const
+		{
+			const Size size{
+				Clamp(static_cast<int32>(Ceil(backScale.x * resolution)), 1, _MAX_CACHE_SIZE),
+				Clamp(static_cast<int32>(Ceil(backScale.y * resolution)), 1, _MAX_CACHE_SIZE) };
+
+			if (cache.size() != size)
+			{
+				cache = RenderTexture{ size };
+			}
+
+			// 背景が全体を覆うので不透明で消しておく(アルファが抜けないようにする)
+			cache.clear(ColorF{ 0.0, 1.0 });
+
+			{
+				const ScopedRenderTarget2D target{ cache };
+				const Transformer2D camera{ Mat3x2::Identity(), Transformer2D::Target::SetCamera };
+				const Transformer2D local{
+					Mat3x2::Translate(backScale / 2.0).scaled(Vec2{ size.x / backScale.x, size.y / backScale.y }),
+					Transformer2D::Target::SetLocal };
+
+				DrawBack();
+				tileMesh.draw(Tile::GetTexture());
+			}
+
+			cacheResolution = resolution;
+		}
+
 		/** ****************************************************************************************************
 		 * @brief			カケラの操作
+		 * @param[in] input	入力の状態
 		 * @retval true		アクションがあった
 		 * @retval false	アクションがなかった
 		 **************************************************************************************************** */
-		bool ProcessAction()
+		bool ProcessAction(const InputData::State& input)
 		{
-			if (CommonKeyState::gINPUT_PIECE_ACTION.up())
+			if (input.isPieceActionUp)
 			{
 				BitFlag::UnPop(flag, _MASK_NOW_ACTION);
 				return false;
@@ -298,7 +541,7 @@ namespace MySystem
 
 			if (nowMoving)
 			{
-				auto cursorPosition = Cursor::PosF();
+				auto cursorPosition = input.cursorPosition;
 				cursorPosition.x = round(cursorPosition.x);
 				cursorPosition.y = round(cursorPosition.y);
 
@@ -306,7 +549,7 @@ namespace MySystem
 			}
 			else if (nowScaling)
 			{
-				auto newScale = (Cursor::PosF() - transform.GetWorldPosition()).length() / (backScale / 2.0).length();
+				auto newScale = (input.cursorPosition - transform.GetWorldPosition()).length() / (backScale / 2.0).length();
 
 				newScale = round(newScale * 10.0) * 0.1;
 
@@ -318,7 +561,7 @@ namespace MySystem
 			{
 				auto position = transform.GetWorldPosition();
 				auto prevDirection = prevCursorPos - position;
-				auto currentDirection = Cursor::PosF() - position;
+				auto currentDirection = input.cursorPosition - position;
 
 				if (currentDirection != Vec2::Zero())
 				{
@@ -338,7 +581,7 @@ namespace MySystem
 				}
 			}
 
-			prevCursorPos = Cursor::PosF();
+			prevCursorPos = input.cursorPosition;
 
 			return true;
 		}
@@ -346,57 +589,58 @@ namespace MySystem
 		/** ****************************************************************************************************
 		 * @brief			カケラの操作決定
 		 * @param[in] body	自身の当たり判定
+		 * @param[in] input	入力の状態
 		 * @retval true		アクションがあった
 		 * @retval false	アクションがなかった
 		 **************************************************************************************************** */
-		bool CheckAction(const Quad& body)
+		bool CheckAction(const Quad& body, const InputData::State& input)
 		{
 			auto bodyScale = GetBodyScale();
 
 			auto size = Min(bodyScale.x, bodyScale.y) / 4.0;
-			auto isDown = CommonKeyState::gINPUT_PIECE_ACTION.down();
+			auto isDown = input.isPieceActionDown;
 
 			if (isDown)
 			{
 				prevScale = transform.GetLocalScale().x;
-				prevCursorPos = Cursor::PosF();
+				prevCursorPos = input.cursorPosition;
 				cursorDistance = (prevCursorPos - transform.GetWorldPosition()).lengthSq() * Max(bodyScale.x, bodyScale.y);
 			}
 
-			if (body.stretched(-size).mouseOver())
+			if (body.stretched(-size).intersects(input.cursorPosition))
 			{
 				if (BitFlag::CheckAnyPop(flag, _CAN_MOVING) && apGimmick.empty())
 				{
-					Cursor::RequestStyle(CursorStyle::Cross);
+					cursorStyle = CursorStyle::Cross;
 					BitFlag::PopOrUnPop(flag, _NOW_MOVING, isDown);
 				}
 				else
 				{
-					Cursor::RequestStyle(CursorStyle::NotAllowed);
+					cursorStyle = CursorStyle::NotAllowed;
 				}
 			}
-			else if (body.mouseOver())
+			else if (body.intersects(input.cursorPosition))
 			{
 				if (BitFlag::CheckAnyPop(flag, _CAN_SCALING))
 				{
-					Cursor::RequestStyle(CursorStyle::ResizeAll);
+					cursorStyle = CursorStyle::ResizeAll;
 					BitFlag::PopOrUnPop(flag, _NOW_SCALING, isDown);
 				}
 				else
 				{
-					Cursor::RequestStyle(CursorStyle::NotAllowed);
+					cursorStyle = CursorStyle::NotAllowed;
 				}
 			}
-			else if (body.stretched(size).mouseOver())
+			else if (body.stretched(size).intersects(input.cursorPosition))
 			{
 				if (BitFlag::CheckAnyPop(flag, _CAN_ROLLING))
 				{
-					Cursor::RequestStyle(CursorStyle::Hand);
+					cursorStyle = CursorStyle::Hand;
 					BitFlag::PopOrUnPop(flag, _NOW_ROLLING, isDown);
 				}
 				else
 				{
-					Cursor::RequestStyle(CursorStyle::NotAllowed);
+					cursorStyle = CursorStyle::NotAllowed;
 				}
 			}
 
@@ -411,6 +655,8 @@ namespace MySystem
 		std::make_pair<String, String>(U"BackNullTexture",		U"Assets/Image/NormalBack.png")
 	};
 
+	std::array<Texture, static_cast<StagePieceData::TypeIndex>(StagePieceData::Type::Max) + 1> StagePiece::Impl::_aTextures;
+
 	StagePiece::StagePiece(const StagePieceData::Desc& data, const uint8 pieceNumber, Stage* pStage, Transform* pParent) noexcept :
 		_pImpl{ new Impl{ data, pieceNumber, pStage, pParent } }
 	{
@@ -419,19 +665,34 @@ namespace MySystem
 
 	StagePiece::~StagePiece() = default;
 
+	void StagePiece::RegisterTextures()
+	{
+		Impl::RegisterTextures();
+	}
+
+	void StagePiece::Reload(const StagePieceData::Desc& oldData, const StagePieceData::Desc& newData) noexcept
+	{
+		_pImpl->Reload(oldData, newData);
+	}
+
 	void StagePiece::Update() noexcept
 	{
 
 	}
 
-	void StagePiece::Draw() const noexcept
+	void StagePiece::Draw(const RectF& viewRect) const noexcept
+	{
+		_pImpl->Draw(viewRect);
+	}
+
+	bool StagePiece::UpdatePiece(const InputData::State& input) noexcept
 	{
-		_pImpl->Draw();
+		return _pImpl->UpdatePiece(input);
 	}
 
-	bool StagePiece::UpdatePiece() noexcept
+	CursorStyle StagePiece::GetCursorStyle() const noexcept
 	{
-		return _pImpl->UpdatePiece();
+		return _pImpl->cursorStyle;
 	}
 
 	void StagePiece::SetActive(const bool isActive) noexcept
@@ -6,6 +6,7 @@
 
 #include <Siv3D.hpp>
 #include "../Data/StagePieceData.h"
+#include "../Data/InputData.h"
 
 namespace MySystem
 {
@@ -37,22 +38,42 @@ namespace MySystem
 		 **************************************************************************************************** */
 		~StagePiece();
 
+		/** ****************************************************************************************************
+		 * @brief カケラのテクスチャを登録(描画する側で一度だけ呼ぶ)
+		 **************************************************************************************************** */
+		static void RegisterTextures();
+
+		/** ****************************************************************************************************
+		 * @brief					変更されたデータで作り直す(座標とギミックはそのまま残す)
+		 * @param[in] oldData		生成に使ったデータ
+		 * @param[in] newData		変更後のデータ
+		 **************************************************************************************************** */
+		void Reload(const StagePieceData::Desc& oldData, const StagePieceData::Desc& newData) noexcept;
+
 		/** ****************************************************************************************************
 		 * @brief 更新
 		 **************************************************************************************************** */
 		void Update() noexcept;
 
 		/** ****************************************************************************************************
-		 * @brief 描画
+		 * @brief				描画
+		 * @param[in] viewRect	画面に映る範囲(ワールド座標、映らないカケラやタイルは描かない)
 		 **************************************************************************************************** */
-		void Draw() const noexcept;
+		void Draw(const RectF& viewRect) const noexcept;
 
 		/** ****************************************************************************************************
 		 * @brief			カケラの更新処理
+		 * @param[in] input	入力の状態(カーソルはワールド座標)
 		 * @retval true		アクションがあった
 		 * @retval false	アクションがなかった
 		 **************************************************************************************************** */
-		bool UpdatePiece() noexcept;
+		bool UpdatePiece(const InputData::State& input) noexcept;
+
+		/** ****************************************************************************************************
+		 * @brief	前回の更新でカーソルが指していた操作に合うカーソルの形を取得
+		 * @return	カーソルの形(何も指していなければ Default)
+		 **************************************************************************************************** */
+		CursorStyle GetCursorStyle() const noexcept;
 
 		/** ****************************************************************************************************
 		 * @brief				有効かどうか設定
@@ -7,49 +7,19 @@
 #include "../Data/TileData.h"
 
 /** ****************************************************************************************************
- * @brief タイル操作関連
+ * @brief タイル操作関連(タイルはカケラがまとめて描くので、ここでは共有のテクスチャだけを持つ)
  **************************************************************************************************** */
-namespace MySystem
+namespace MySystem::Tile
 {
-	class Tile
-	{
-	private:
-		class Impl;
-		std::unique_ptr<Impl> _pImpl;
-
-	public:
-		Tile() = delete;
-		Tile(const Tile&) = delete;
-		Tile& operator=(const Tile&) = delete;
-
-		/** ****************************************************************************************************
-		 * @brief				コンストラクタ
-		 * @oaram[in] data		生成用データ
-		 * @param[in] pParent	親
-		 **************************************************************************************************** */
-		Tile(const TileData::Desc& data, class Transform* pParent) noexcept;
-
-		/** ****************************************************************************************************
-		 * @brief デストラクタ
-		 **************************************************************************************************** */
-		~Tile();
-
-		/** ****************************************************************************************************
-		 * @brief 描画
-		 **************************************************************************************************** */
-		void Draw() const noexcept;
-
-		/** ****************************************************************************************************
-		 * @brief	自身のワールド内の当たり判定取得
-		 * @return	当たり判定
-		 **************************************************************************************************** */
-		Polygon GetWorldHitBox() const;
-
-		/** ****************************************************************************************************
-		 * @brief	自身の当たり判定取得
-		 * @return	当たり判定
-		 **************************************************************************************************** */
-		Polygon GetLocalHitBox() const;
-	};
+	/** ****************************************************************************************************
+	 * @brief タイルのテクスチャを登録(描画する側で一度だけ呼ぶ)
+	 **************************************************************************************************** */
+	void RegisterTextures();
+
+	/** ****************************************************************************************************
+	 * @brief	タイルのテクスチャを取得(登録時に解決しておいたものを返す)
+	 * @return	テクスチャ
+	 **************************************************************************************************** */
+	const Texture& GetTexture() noexcept;
 }
 
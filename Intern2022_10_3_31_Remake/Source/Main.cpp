@@ -3,11 +3,36 @@
 #include "Scene/TitleScene.h"
 #include "Scene/StageSelectScene.h"
 #include "Scene/GameScene.h"
+#include "Benchmark/Benchmark.h"
+
+#include "GameObject/Data/StageData.h"
+#include "GameObject/Object/Stage.h"
+
+#if defined(MY_BENCHMARK) || defined(MY_COMPILE_STAGE)
+// 計測用・変換用ビルドはウィンドウを出さない
+SIV3D_SET(EngineOption::Renderer::Headless)
+#endif
 
 void Main()
 {
+#if defined(MY_BENCHMARK)
+	// 計測用ビルドは計測だけして終了する
+	MySystem::Benchmark::Run(U"benchmark.csv");
+	return;
+#elif defined(MY_COMPILE_STAGE)
+	// 変換用ビルドはステージの CSV を全て変換して終了する
+	MySystem::StageData::CompileAll();
+	return;
+#endif
+
 	Window::Resize(1200, 720);
 
+	// ステージの一覧は名前と索引だけで作り、ステージ本体は選んだ時に読む
+	MySystem::StageData::ScanCatalog();
+
+	// ステージ選択のプレビューもステージを描画するので、どのシーンより先に登録する
+	MySystem::Stage::RegisterAssets();
+
 	MySystem::App manager;
 	manager.add<MySystem::TitleScene>(U"Title");
 	manager.add<MySystem::SelectScene>(U"Select");
@@ -1,5 +1,7 @@
 ﻿#include "GameScene.h"
 #include "../GameObject/Object/Stage.h"
+#include "../Utility/FixedTimeStep.h"
+#include "../Utility/CommonKey.h"
 
 namespace MySystem
 {
@@ -7,12 +9,59 @@ namespace MySystem
 	{
 	public:
 		Stage stage;
+		FixedTimeStep timeStep;
+#if defined(MY_HOT_RELOAD)
+		DirectoryWatcher watcher;						//!< ステージのフォルダの監視
+		std::shared_ptr<const StageData::Desc> pDesc;	//!< ステージの生成に使ったデータ
+#endif
 
 		Impl() :
-			stage{ Scene::Center(), Vec2{1.0, 1.0}, 0.0, nullptr }
+			stage{ Scene::Center(), Vec2{1.0, 1.0}, 0.0, nullptr },
+			timeStep{}
+#if defined(MY_HOT_RELOAD)
+			, watcher{ FilePath{ StageData::GetDataFolder() } },
+			pDesc{ nullptr }
+#endif
 		{
 
 		}
+
+#if defined(MY_HOT_RELOAD)
+		/** ****************************************************************************************************
+		 * @brief					遊んでいるステージのファイルが変わっていたら読み直して変わったカケラだけ作り直す
+		 * @param[in] worldIndex	遊んでいるワールド番号
+		 * @param[in] stageIndex	遊んでいるステージ番号
+		 **************************************************************************************************** */
+		void HotReload(const StageData::WorldIndex worldIndex, const StageData::StageIndex stageIndex)
+		{
+			// 保存1回で複数の通知が来るので、まとめて1度だけ読み直す
+			bool isChanged = false;
+
+			for (const auto& change : watcher.retrieveChanges())
+			{
+				if (change.action != FileAction::Removed &&
+					StageData::IsStagePath(change.path, worldIndex, stageIndex))
+				{
+					isChanged = true;
+				}
+			}
+
+			if (not isChanged)
+			{
+				return;
+			}
+
+			auto pNewDesc = StageData::Reload(worldIndex, stageIndex);
+
+			if (not pNewDesc)
+			{
+				return;
+			}
+
+			stage.ReloadStage(*pDesc, *pNewDesc);
+			pDesc = std::move(pNewDesc);
+		}
+#endif
 	};
 
 	GameScene::GameScene(const InitData& init) :
@@ -21,6 +70,10 @@ namespace MySystem
 	{
 		auto& data = getData();
 		_pImpl->stage.CreateStage(data.worldIndex, data.stageIndex);
+
+#if defined(MY_HOT_RELOAD)
+		_pImpl->pDesc = StageData::GetCurrentData();
+#endif
 	}
 
 	GameScene::~GameScene()
@@ -30,13 +83,45 @@ namespace MySystem
 
 	void GameScene::update()
 	{
-		_pImpl->stage.Update();
+		auto& stage = _pImpl->stage;
+		auto& timeStep = _pImpl->timeStep;
+
+#if defined(MY_HOT_RELOAD)
+		// 開発用ビルドはステージのファイルを保存するとその場で反映する
+		_pImpl->HotReload(getData().worldIndex, getData().stageIndex);
+#endif
+
+		// ステージは入力を直接見ないので、ここで1フレーム分の入力をまとめて渡す
+		const auto input = CommonKeyState::GetInputState();
+
+		stage.Update(input);
+
+		// 描画のフレームレートに関わらず、シミュレーションは固定時間で進める
+		const bool isGameEnd = stage.IsGameEnd();
+
+		for (auto i : step(timeStep.Advance(Scene::DeltaTime())))
+		{
+			stage.FixedUpdate(timeStep.GetStepTime(), input);
+
+			// プレイ中にゲームが終わったら残りの分は進めず、次のフレームで切り替えた更新から進める
+			if (not isGameEnd && stage.IsGameEnd())
+			{
+				break;
+			}
+		}
+
+		stage.SetInterpolation(timeStep.GetInterpolation());
+
+		if (stage.GetCursorStyle() != CursorStyle::Default)
+		{
+			Cursor::RequestStyle(stage.GetCursorStyle());
+		}
 
-		if (_pImpl->stage.LoadStageWait())
+		if (stage.LoadStageWait())
 		{
 			changeScene(U"Game");
 		}
-		else if (_pImpl->stage.LoadSelectWait())
+		else if (stage.LoadSelectWait())
 		{
 			changeScene(U"Select");
 		}
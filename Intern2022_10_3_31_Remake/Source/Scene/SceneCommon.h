@@ -10,9 +10,6 @@ namespace MySystem
 	 **************************************************************************************************** */
 	struct CommonSceneData
 	{
-		static constexpr StageData::WorldIndex gMAX_WORLD_NUM = 1;	//!< ワールドの最大数
-		static constexpr StageData::StageIndex gMAX_STAGE_NUM = 5;	//!< ステージの最大数
-
 		StageData::WorldIndex worldIndex;	//!< 現在のワールド
 		StageData::StageIndex stageIndex;	//!< 現在のステージ
 
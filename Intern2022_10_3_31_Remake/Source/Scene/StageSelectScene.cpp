@@ -85,12 +85,12 @@ namespace MySystem
 			}
 		}
 
-		void Create(const StageData::WorldIndex& worldIndex, const StageData::StageIndex& stageIndex)
+		void Create(const StageData::WorldIndex& worldIndex, const StageData::StageIndex& stageIndex, const String& stageName)
 		{
 			_worldText = U"W{:2d}"_fmt(worldIndex + 1);
 			_stageText = U"S{:2d} : "_fmt(stageIndex + 1);
 
-			_stageText += StageData::GetCurrentData()->stageName;
+			_stageText += stageName;
 		}
 
 		void SetRate(const double rate)
@@ -184,6 +184,15 @@ namespace MySystem
 			WaitLoadStage
 		};
 
+		/** ****************************************************************************************************
+		 * @brief 別スレッドで生成したステージ
+		 **************************************************************************************************** */
+		struct _LoadResult
+		{
+			std::shared_ptr<const StageData::Desc>	pDesc;	//!< 生成に使ったデータ(読み込めなければ nullptr)
+			std::unique_ptr<Stage>					pStage;	//!< 生成したステージ(読み込めなければ nullptr)
+		};
+
 		static constexpr double _STAGE_SCALE = 0.6;
 
 		StageData::WorldIndex _worldIndex;
@@ -191,23 +200,34 @@ namespace MySystem
 
 		_Type		_type;
 		Stopwatch	_stopWatch;
+		bool		_isPlayRequested;	//!< 遊ぶボタンが押されたか(次のステージを作り終えるまで遷移を待たせる)
 
-		Stage	_stage;
+		std::unique_ptr<Stage>	_pStage;
+		AsyncTask<_LoadResult>	_loadTask;
 		Header	_header;
 		Footer	_footer;
 
 	public:
-		StageView(const StageData::WorldIndex& worldIndex, const StageData::StageIndex& stageIndex) :
-			_worldIndex{worldIndex},
-			_stageIndex{stageIndex},
+		StageView(CommonSceneData& data) :
+			_worldIndex{},
+			_stageIndex{},
 			_type{ _Type::Main },
 			_stopWatch{},
-			_stage{ Scene::CenterF(), Vec2{ _STAGE_SCALE, _STAGE_SCALE }, 0.0, nullptr },
+			_isPlayRequested{ false },
+			_pStage{ std::make_unique<Stage>(Scene::CenterF(), Vec2{ _STAGE_SCALE, _STAGE_SCALE }, 0.0, nullptr) },
+			_loadTask{},
 			_header{},
 			_footer{}
 		{
 			auto size = Scene::Size() - (Scene::Size() * _STAGE_SCALE);
 
+			// 前の画面から渡された番号が一覧に無ければ、一覧にある番号から始める
+			data.worldIndex = GetNearest(StageData::GetCatalogWorlds(), data.worldIndex);
+			data.stageIndex = GetNearest(StageData::GetCatalogStages(data.worldIndex), data.stageIndex);
+
+			_worldIndex = data.worldIndex;
+			_stageIndex = data.stageIndex;
+
 			Create(_worldIndex, _stageIndex);
 		}
 
@@ -231,6 +251,12 @@ namespace MySystem
 			_footer.Update();
 
 			if (_footer.GetPlayButtonIsOn())
+			{
+				_isPlayRequested = true;
+			}
+
+			// 次のステージを作っている途中で遷移すると破棄する時に完了を待って止まるので、受け取ってから遷移する
+			if (_isPlayRequested && not _loadTask.isValid())
 			{
 				_type = _Type::WaitLoadStage;
 			}
@@ -238,7 +264,7 @@ namespace MySystem
 
 		void Draw() const
 		{
-			_stage.Draw();
+			_pStage->Draw();
 			_header.Draw();
 			_footer.Draw();
 		}
@@ -251,33 +277,28 @@ namespace MySystem
 	private:
 		void MainUpdate(CommonSceneData& data)
 		{
-			if (CommonKeyState::gINPUT_LEFT.down())
+			// 番号が飛んでいても一覧にあるステージだけを順に選ぶ
+			if (CommonKeyState::gINPUT_DOWN.down())
 			{
-				if (data.stageIndex > 0)
-				{
-					data.stageIndex--;
-				}
+				data.worldIndex = GetNeighbor(StageData::GetCatalogWorlds(), data.worldIndex, false);
 			}
-			if (CommonKeyState::gINPUT_RIGHT.down())
+			if (CommonKeyState::gINPUT_UP.down())
 			{
-				if (data.stageIndex < CommonSceneData::gMAX_STAGE_NUM - 1)
-				{
-					data.stageIndex++;
-				}
+				data.worldIndex = GetNeighbor(StageData::GetCatalogWorlds(), data.worldIndex, true);
 			}
-			if (CommonKeyState::gINPUT_DOWN.down())
+
+			const auto& aStages = StageData::GetCatalogStages(data.worldIndex);
+
+			// ワールドを変えて同じ番号のステージが無ければ一番近い手前のステージにする
+			data.stageIndex = GetNearest(aStages, data.stageIndex);
+
+			if (CommonKeyState::gINPUT_LEFT.down())
 			{
-				if (data.worldIndex > 0)
-				{
-					data.worldIndex--;
-				}
+				data.stageIndex = GetNeighbor(aStages, data.stageIndex, false);
 			}
-			if (CommonKeyState::gINPUT_UP.down())
+			if (CommonKeyState::gINPUT_RIGHT.down())
 			{
-				if (data.worldIndex < CommonSceneData::gMAX_WORLD_NUM - 1)
-				{
-					data.worldIndex++;
-				}
+				data.stageIndex = GetNeighbor(aStages, data.stageIndex, true);
 			}
 
 			if (data.stageIndex != _stageIndex || data.worldIndex != _worldIndex)
@@ -285,6 +306,9 @@ namespace MySystem
 				_worldIndex = data.worldIndex;
 				_stageIndex = data.stageIndex;
 
+				// 縮小している間に次のステージを作っておく
+				_loadTask = Async(LoadStage, _worldIndex, _stageIndex, Scene::CenterF());
+
 				_type = _Type::UnPop;
 				_stopWatch.restart();
 			}
@@ -296,16 +320,21 @@ namespace MySystem
 
 			double rate = _stopWatch.sF() / FADE_IN_TIME;
 
+			// 読み込みが終わっていなければ縮みきった状態で待つ
 			if (rate >= 1.0)
 			{
 				rate = 1.0;
-				Create(_worldIndex, _stageIndex);
-				_stopWatch.restart();
-				_type = _Type::Pop;
+
+				if (_loadTask.isReady())
+				{
+					Apply(_loadTask.get());
+					_stopWatch.restart();
+					_type = _Type::Pop;
+				}
 			}
 
 			auto newScale = _STAGE_SCALE * (1.0 - rate);
-			_stage.SetLocalScale(Vec2{ newScale, newScale });
+			_pStage->SetLocalScale(Vec2{ newScale, newScale });
 			_header.SetRate(rate);
 			_footer.SetRate(rate);
 		}
@@ -324,15 +353,96 @@ namespace MySystem
 			}
 
 			auto newScale = _STAGE_SCALE * rate;
-			_stage.SetLocalScale(Vec2{ newScale, newScale });
+			_pStage->SetLocalScale(Vec2{ newScale, newScale });
 			_header.SetRate(1.0 - rate);
 			_footer.SetRate(1.0 - rate);
 		}
 
 		void Create(const StageData::WorldIndex& worldIndex, const StageData::StageIndex& stageIndex)
 		{
-			_stage.CreateStage(worldIndex, stageIndex);
-			_header.Create(worldIndex, stageIndex);
+			_pStage->CreateStage(worldIndex, stageIndex);
+			_header.Create(worldIndex, stageIndex, GetStageName(worldIndex, stageIndex));
+		}
+
+		void Apply(_LoadResult result)
+		{
+			// 読み込めなかった場合は従来通りその場で既定のステージを作る
+			if (not result.pStage)
+			{
+				Create(_worldIndex, _stageIndex);
+				return;
+			}
+
+			_pStage = std::move(result.pStage);
+			_header.Create(_worldIndex, _stageIndex, GetStageName(_worldIndex, _stageIndex));
+		}
+
+		/** ****************************************************************************************************
+		 * @brief					ステージ名を取得(一覧を作った時に読んだまとめファイルの索引から引く)
+		 * @param[in] worldIndex	ワールド番号
+		 * @param[in] stageIndex	ステージ番号
+		 * @return					ステージ名(ステージが無ければ空)
+		 **************************************************************************************************** */
+		static String GetStageName(const StageData::WorldIndex worldIndex, const StageData::StageIndex stageIndex)
+		{
+			const auto summary = StageData::GetSummary(worldIndex, stageIndex);
+
+			return summary ? summary->stageName : String{};
+		}
+
+		/** ****************************************************************************************************
+		 * @brief					一覧の中で隣の番号を取得
+		 * @param[in] aIndices		小さい順の番号の一覧
+		 * @param[in] current		現在の番号
+		 * @param[in] isNext		次の番号か(false なら前の番号)
+		 * @return					隣の番号(隣が無ければ現在の番号)
+		 **************************************************************************************************** */
+		template<class Index>
+		static Index GetNeighbor(const Array<Index>& aIndices, const Index current, const bool isNext)
+		{
+			if (isNext)
+			{
+				const auto itr = std::upper_bound(aIndices.begin(), aIndices.end(), current);
+				return (itr == aIndices.end()) ? current : *itr;
+			}
+
+			const auto itr = std::lower_bound(aIndices.begin(), aIndices.end(), current);
+			return (itr == aIndices.begin()) ? current : *std::prev(itr);
+		}
+
+		/** ****************************************************************************************************
+		 * @brief					一覧の中で一番近い手前の番号を取得
+		 * @param[in] aIndices		小さい順の番号の一覧
+		 * @param[in] current		現在の番号
+		 * @return					一覧にある番号(手前が無ければ先頭、一覧が空なら現在の番号)
+		 **************************************************************************************************** */
+		template<class Index>
+		static Index GetNearest(const Array<Index>& aIndices, const Index current)
+		{
+			if (aIndices.empty() || std::binary_search(aIndices.begin(), aIndices.end(), current))
+			{
+				return current;
+			}
+
+			const auto itr = std::upper_bound(aIndices.begin(), aIndices.end(), current);
+			return (itr == aIndices.begin()) ? aIndices.front() : *std::prev(itr);
+		}
+
+		static _LoadResult LoadStage(const StageData::WorldIndex worldIndex, const StageData::StageIndex stageIndex, const Vec2 position)
+		{
+			_LoadResult result;
+
+			result.pDesc = StageData::Acquire(worldIndex, stageIndex);
+
+			if (not result.pDesc)
+			{
+				return result;
+			}
+
+			result.pStage = std::make_unique<Stage>(position, Vec2{ _STAGE_SCALE, _STAGE_SCALE }, 0.0, nullptr);
+			result.pStage->CreateStage(*result.pDesc);
+
+			return result;
 		}
 	};
 
@@ -341,8 +451,8 @@ namespace MySystem
 	public:
 		StageView stage;
 
-		Impl(const StageData::WorldIndex& worldIndex, const StageData::StageIndex& stageIndex) :
-			stage{ worldIndex, stageIndex }
+		Impl(CommonSceneData& data) :
+			stage{ data }
 		{
 
 		}
@@ -350,7 +460,7 @@ namespace MySystem
 
 	SelectScene::SelectScene(const InitData& init) :
 		IScene{ init },
-		_pImpl{ new Impl{ getData().worldIndex, getData().stageIndex }}
+		_pImpl{ new Impl{ getData() }}
 	{
 	}
 
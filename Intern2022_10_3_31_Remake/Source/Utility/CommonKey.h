@@ -5,6 +5,7 @@
 #pragma once
 
 #include <Siv3D.hpp>
+#include "../GameObject/Data/InputData.h"
 
 /** ****************************************************************************************************
  * @brief ゲーム内共通で使用する入力
@@ -17,9 +18,33 @@ namespace MySystem::CommonKeyState
 	static const InputGroup gINPUT_DOWN = (KeyDown | KeyS);		//<! 右移動用キー
 	static const InputGroup gINPUT_JUMP = (KeyW | KeySpace);	//<! ジャンプ用キー
 	static const InputGroup gINPUT_ANY_KEY = (gINPUT_LEFT | gINPUT_RIGHT | gINPUT_UP | gINPUT_DOWN | gINPUT_JUMP);	//<! 使用しているいずれかのキー
+	static const InputGroup gINPUT_RETRY = (KeyEnter);	//<! やり直し用キー
 
 	static const InputGroup gINPUT_SUBMIT = (MouseL);		//<! 決定用マウスボタン
 	static const InputGroup gINPUT_CANCEL = (MouseR);		//<! キャンセル用マウスボタン
 	static const InputGroup gINPUT_PIECE_ACTION = (MouseR);	//<! カケラ操作用マウスボタン
 	static const InputGroup gINPUT_ANY_MOUSE = (gINPUT_SUBMIT | gINPUT_CANCEL | gINPUT_PIECE_ACTION);	//<! 使用しているいずれかのマウスボタン
+
+	/** ****************************************************************************************************
+	 * @brief	現在の入力の状態を取得
+	 * @return	ゲームの更新に渡す入力の状態
+	 **************************************************************************************************** */
+	[[nodiscard]]
+	inline InputData::State GetInputState()
+	{
+		InputData::State state;
+
+		state.isLeftPressed		= gINPUT_LEFT.pressed();
+		state.isRightPressed	= gINPUT_RIGHT.pressed();
+		state.isJumpPressed		= gINPUT_JUMP.pressed();
+		state.isAnyKeyPressed	= gINPUT_ANY_KEY.pressed();
+		state.isAnyMousePressed	= gINPUT_ANY_MOUSE.pressed();
+		state.isSubmitDown		= gINPUT_SUBMIT.down();
+		state.isPieceActionDown	= gINPUT_PIECE_ACTION.down();
+		state.isPieceActionUp	= gINPUT_PIECE_ACTION.up();
+		state.isRetryDown		= gINPUT_RETRY.down();
+		state.cursorPosition	= Cursor::PosF();
+
+		return state;
+	}
 }
@@ -0,0 +1,96 @@
+﻿/** ****************************************************************************************************
+ * @file
+ * @brief 固定時間での更新関連
+ **************************************************************************************************** */
+#pragma once
+
+#include <Siv3D.hpp>
+
+namespace MySystem
+{
+	/** ****************************************************************************************************
+	 * @brief 経過時間を溜めて、固定の時間ごとに更新回数を返す
+	 **************************************************************************************************** */
+	class FixedTimeStep
+	{
+	private:
+		static constexpr double _DEFAULT_STEP_RATE = 60.0;	//!< 1秒当たりの更新回数の初期値
+		static constexpr size_t _DEFAULT_MAX_STEP_NUM = 5;	//!< 1フレームで更新する最大回数の初期値
+
+		double	_stepTime;		//!< 1回の更新で進める時間
+		double	_accumulator;	//!< まだ更新に使っていない時間
+		size_t	_maxStepNum;	//!< 1フレームで更新する最大回数
+
+	public:
+		/** ****************************************************************************************************
+		 * @brief					コンストラクタ
+		 * @param[in] stepRate		1秒当たりの更新回数
+		 * @param[in] maxStepNum	1フレームで更新する最大回数
+		 **************************************************************************************************** */
+		inline FixedTimeStep(const double stepRate = _DEFAULT_STEP_RATE, const size_t maxStepNum = _DEFAULT_MAX_STEP_NUM) noexcept :
+			_stepTime{ 1.0 / stepRate },
+			_accumulator{ 0.0 },
+			_maxStepNum{ maxStepNum }
+		{
+
+		}
+
+		/** ****************************************************************************************************
+		 * @brief					経過時間を溜めて、今回の更新回数を取得
+		 * @param[in] deltaTime		前回からの経過時間
+		 * @return					今回の更新回数
+		 **************************************************************************************************** */
+		inline size_t Advance(const double deltaTime) noexcept
+		{
+			_accumulator += deltaTime;
+
+			auto stepNum = static_cast<size_t>(_accumulator / _stepTime);
+
+			// 処理落ちした時に更新が追いつかなくならないよう、溢れた分は捨てる
+			if (stepNum > _maxStepNum)
+			{
+				stepNum = _maxStepNum;
+				_accumulator = _stepTime * static_cast<double>(stepNum);
+			}
+
+			_accumulator -= _stepTime * static_cast<double>(stepNum);
+
+			return stepNum;
+		}
+
+		/** ****************************************************************************************************
+		 * @brief				1秒当たりの更新回数を設定
+		 * @param[in] stepRate	1秒当たりの更新回数
+		 **************************************************************************************************** */
+		inline void SetStepRate(const double stepRate) noexcept
+		{
+			_stepTime = 1.0 / stepRate;
+		}
+
+		/** ****************************************************************************************************
+		 * @brief	1回の更新で進める時間を取得
+		 * @return	1回の更新で進める時間
+		 **************************************************************************************************** */
+		inline double GetStepTime() const noexcept
+		{
+			return _stepTime;
+		}
+
+		/** ****************************************************************************************************
+		 * @brief	前回の更新から次の更新までの割合を取得(描画の補間用)
+		 * @return	0.0 ~ 1.0 の割合
+		 **************************************************************************************************** */
+		inline double GetInterpolation() const noexcept
+		{
+			return Clamp(_accumulator / _stepTime, 0.0, 1.0);
+		}
+
+		/** ****************************************************************************************************
+		 * @brief 溜めた時間を捨てる
+		 **************************************************************************************************** */
+		inline void Reset() noexcept
+		{
+			_accumulator = 0.0;
+		}
+	};
+}
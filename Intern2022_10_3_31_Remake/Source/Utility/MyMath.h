@@ -6,6 +6,14 @@
 
 #include <Siv3D.hpp>
 
+#if defined(__AVX2__)
+#	include <immintrin.h>
+#	define MY_MATH_USE_AVX2
+#elif defined(_M_X64) || defined(__SSE2__)
+#	include <emmintrin.h>
+#	define MY_MATH_USE_SSE2
+#endif
+
 /** ****************************************************************************************************
  * @brief 数学系
  **************************************************************************************************** */
@@ -91,6 +99,298 @@ namespace MySystem::MyMath
 		return true;
 	}
 
+	/** ****************************************************************************************************
+	 * @brief 一括で当たり判定を取るための線分群(要素ごとに別の配列で持つ)
+	 **************************************************************************************************** */
+	struct SegmentBlock
+	{
+		Array<double> aStartX;	//!< 始点の x
+		Array<double> aStartY;	//!< 始点の y
+		Array<double> aEndX;	//!< 終点の x
+		Array<double> aEndY;	//!< 終点の y
+
+		/** ****************************************************************************************************
+		 * @brief 全て削除(確保した領域は使いまわす)
+		 **************************************************************************************************** */
+		inline void Clear() noexcept
+		{
+			aStartX.clear();
+			aStartY.clear();
+			aEndX.clear();
+			aEndY.clear();
+		}
+
+		/** ****************************************************************************************************
+		 * @brief				線分を追加
+		 * @param[in] start		始点
+		 * @param[in] end		終点
+		 **************************************************************************************************** */
+		inline void Add(const Vec2& start, const Vec2& end)
+		{
+			aStartX << start.x;
+			aStartY << start.y;
+			aEndX << end.x;
+			aEndY << end.y;
+		}
+
+		/** ****************************************************************************************************
+		 * @brief	線分の数を取得
+		 * @return	線分の数
+		 **************************************************************************************************** */
+		inline size_t Size() const noexcept
+		{
+			return aStartX.size();
+		}
+	};
+
+	/** ****************************************************************************************************
+	 * @brief					1本の線分と線分群の当たり判定のうち、1本目の線分の始点に一番近いものを求める
+	 * @param[in] segmentStart	線分の始点
+	 * @param[in] segmentEnd	線分の終点
+	 * @param[in] block			線分群
+	 * @param[in] maxT			これ以上の割合で当たったものは無視する
+	 * @param[out] hitIndex		当たった線分群の番号
+	 * @param[out] t			当たった場合の割合
+	 * @param[out] fixHitPos	当たった位置に修正された終点
+	 * @retval true				当たった
+	 * @retval false			当たっていない
+	 **************************************************************************************************** */
+	inline bool HitCheckSegmentToSegments(
+		const Vec2& segmentStart, const Vec2& segmentEnd,
+		const SegmentBlock& block,
+		double maxT,
+		size_t& hitIndex,
+		double& t,
+		Vec2& fixHitPos
+	)
+	{
+		// HitCheckSegmentToSegment と同じ許容誤差
+		const double eps = 0.001;
+		const Vec2 dir1 = segmentEnd - segmentStart;
+		const size_t size = block.Size();
+
+		double bestT = maxT;		// 今までで一番近い割合(始点からの距離の比)
+		double bestHitT = 0.0;		// その時の符号付きの割合
+		size_t bestIndex = size;	// その時の番号
+		size_t i = 0;
+
+#if defined(MY_MATH_USE_AVX2)
+		{
+			const __m256d startX = _mm256_set1_pd(segmentStart.x);
+			const __m256d startY = _mm256_set1_pd(segmentStart.y);
+			const __m256d dir1X = _mm256_set1_pd(dir1.x);
+			const __m256d dir1Y = _mm256_set1_pd(dir1.y);
+			const __m256d minT = _mm256_set1_pd(-eps);
+			const __m256d maxT1 = _mm256_set1_pd(1.0 + eps);
+			const __m256d zero = _mm256_setzero_pd();
+			const __m256d signMask = _mm256_set1_pd(-0.0);
+			__m256d laneBestT = _mm256_set1_pd(maxT);
+			__m256d laneBestHitT = zero;
+			__m256d laneBestIndex = _mm256_set1_pd(static_cast<double>(size));
+			__m256d laneIndex = _mm256_set_pd(3.0, 2.0, 1.0, 0.0);
+			const __m256d indexStep = _mm256_set1_pd(4.0);
+
+			for (; i + 4 <= size; i += 4)
+			{
+				const __m256d sX = _mm256_loadu_pd(&block.aStartX[i]);
+				const __m256d sY = _mm256_loadu_pd(&block.aStartY[i]);
+				const __m256d dir2X = _mm256_sub_pd(_mm256_loadu_pd(&block.aEndX[i]), sX);
+				const __m256d dir2Y = _mm256_sub_pd(_mm256_loadu_pd(&block.aEndY[i]), sY);
+				const __m256d vX = _mm256_sub_pd(sX, startX);
+				const __m256d vY = _mm256_sub_pd(sY, startY);
+
+				const __m256d crsV1V2 = _mm256_sub_pd(_mm256_mul_pd(dir1X, dir2Y), _mm256_mul_pd(dir1Y, dir2X));
+				const __m256d crsVV1 = _mm256_sub_pd(_mm256_mul_pd(vX, dir1Y), _mm256_mul_pd(vY, dir1X));
+				const __m256d crsVV2 = _mm256_sub_pd(_mm256_mul_pd(vX, dir2Y), _mm256_mul_pd(vY, dir2X));
+				const __m256d t1 = _mm256_div_pd(crsVV2, crsV1V2);
+				const __m256d t2 = _mm256_div_pd(crsVV1, crsV1V2);
+				const __m256d absT1 = _mm256_andnot_pd(signMask, t1);
+
+				// 平行でなく、両方の線分の範囲内で、今までより近いもの
+				__m256d mask = _mm256_cmp_pd(crsV1V2, zero, _CMP_NEQ_OQ);
+				mask = _mm256_and_pd(mask, _mm256_cmp_pd(t1, minT, _CMP_GE_OQ));
+				mask = _mm256_and_pd(mask, _mm256_cmp_pd(t1, maxT1, _CMP_LE_OQ));
+				mask = _mm256_and_pd(mask, _mm256_cmp_pd(t2, minT, _CMP_GE_OQ));
+				mask = _mm256_and_pd(mask, _mm256_cmp_pd(t2, maxT1, _CMP_LE_OQ));
+				mask = _mm256_and_pd(mask, _mm256_cmp_pd(absT1, laneBestT, _CMP_LT_OQ));
+
+				laneBestT = _mm256_blendv_pd(laneBestT, absT1, mask);
+				laneBestHitT = _mm256_blendv_pd(laneBestHitT, t1, mask);
+				laneBestIndex = _mm256_blendv_pd(laneBestIndex, laneIndex, mask);
+				laneIndex = _mm256_add_pd(laneIndex, indexStep);
+			}
+
+			alignas(32) double aLaneT[4], aLaneHitT[4], aLaneIndex[4];
+			_mm256_store_pd(aLaneT, laneBestT);
+			_mm256_store_pd(aLaneHitT, laneBestHitT);
+			_mm256_store_pd(aLaneIndex, laneBestIndex);
+
+			for (size_t lane = 0; lane < 4; ++lane)
+			{
+				const auto index = static_cast<size_t>(aLaneIndex[lane]);
+
+				if (aLaneT[lane] < bestT || (aLaneT[lane] == bestT && index < bestIndex))
+				{
+					bestT = aLaneT[lane];
+					bestHitT = aLaneHitT[lane];
+					bestIndex = index;
+				}
+			}
+		}
+#elif defined(MY_MATH_USE_SSE2)
+		{
+			const __m128d startX = _mm_set1_pd(segmentStart.x);
+			const __m128d startY = _mm_set1_pd(segmentStart.y);
+			const __m128d dir1X = _mm_set1_pd(dir1.x);
+			const __m128d dir1Y = _mm_set1_pd(dir1.y);
+			const __m128d minT = _mm_set1_pd(-eps);
+			const __m128d maxT1 = _mm_set1_pd(1.0 + eps);
+			const __m128d zero = _mm_setzero_pd();
+			const __m128d signMask = _mm_set1_pd(-0.0);
+			__m128d laneBestT = _mm_set1_pd(maxT);
+			__m128d laneBestHitT = zero;
+			__m128d laneBestIndex = _mm_set1_pd(static_cast<double>(size));
+			__m128d laneIndex = _mm_set_pd(1.0, 0.0);
+			const __m128d indexStep = _mm_set1_pd(2.0);
+
+			// SSE2 には blend が無いので論理演算で選ぶ
+			auto select = [](__m128d a, __m128d b, __m128d mask)
+			{
+				return _mm_or_pd(_mm_andnot_pd(mask, a), _mm_and_pd(mask, b));
+			};
+
+			for (; i + 2 <= size; i += 2)
+			{
+				const __m128d sX = _mm_loadu_pd(&block.aStartX[i]);
+				const __m128d sY = _mm_loadu_pd(&block.aStartY[i]);
+				const __m128d dir2X = _mm_sub_pd(_mm_loadu_pd(&block.aEndX[i]), sX);
+				const __m128d dir2Y = _mm_sub_pd(_mm_loadu_pd(&block.aEndY[i]), sY);
+				const __m128d vX = _mm_sub_pd(sX, startX);
+				const __m128d vY = _mm_sub_pd(sY, startY);
+
+				const __m128d crsV1V2 = _mm_sub_pd(_mm_mul_pd(dir1X, dir2Y), _mm_mul_pd(dir1Y, dir2X));
+				const __m128d crsVV1 = _mm_sub_pd(_mm_mul_pd(vX, dir1Y), _mm_mul_pd(vY, dir1X));
+				const __m128d crsVV2 = _mm_sub_pd(_mm_mul_pd(vX, dir2Y), _mm_mul_pd(vY, dir2X));
+				const __m128d t1 = _mm_div_pd(crsVV2, crsV1V2);
+				const __m128d t2 = _mm_div_pd(crsVV1, crsV1V2);
+				const __m128d absT1 = _mm_andnot_pd(signMask, t1);
+
+				// 平行でなく、両方の線分の範囲内で、今までより近いもの
+				__m128d mask = _mm_cmpneq_pd(crsV1V2, zero);
+				mask = _mm_and_pd(mask, _mm_cmpge_pd(t1, minT));
+				mask = _mm_and_pd(mask, _mm_cmple_pd(t1, maxT1));
+				mask = _mm_and_pd(mask, _mm_cmpge_pd(t2, minT));
+				mask = _mm_and_pd(mask, _mm_cmple_pd(t2, maxT1));
+				mask = _mm_and_pd(mask, _mm_cmplt_pd(absT1, laneBestT));
+
+				laneBestT = select(laneBestT, absT1, mask);
+				laneBestHitT = select(laneBestHitT, t1, mask);
+				laneBestIndex = select(laneBestIndex, laneIndex, mask);
+				laneIndex = _mm_add_pd(laneIndex, indexStep);
+			}
+
+			alignas(16) double aLaneT[2], aLaneHitT[2], aLaneIndex[2];
+			_mm_store_pd(aLaneT, laneBestT);
+			_mm_store_pd(aLaneHitT, laneBestHitT);
+			_mm_store_pd(aLaneIndex, laneBestIndex);
+
+			for (size_t lane = 0; lane < 2; ++lane)
+			{
+				const auto index = static_cast<size_t>(aLaneIndex[lane]);
+
+				if (aLaneT[lane] < bestT || (aLaneT[lane] == bestT && index < bestIndex))
+				{
+					bestT = aLaneT[lane];
+					bestHitT = aLaneHitT[lane];
+					bestIndex = index;
+				}
+			}
+		}
+#endif
+
+		// 残り(またはSIMDが使えない環境では全て)
+		for (; i < size; ++i)
+		{
+			const Vec2 start{ block.aStartX[i], block.aStartY[i] };
+			const Vec2 dir2 = Vec2{ block.aEndX[i], block.aEndY[i] } - start;
+			const Vec2 v = start - segmentStart;
+			const double crsV1V2 = dir1.cross(dir2);
+
+			if (crsV1V2 == 0.0)
+			{
+				continue;
+			}
+
+			const double t1 = v.cross(dir2) / crsV1V2;
+			const double t2 = v.cross(dir1) / crsV1V2;
+
+			if (t1 < -eps || t1 > 1.0 + eps || t2 < -eps || t2 > 1.0 + eps)
+			{
+				continue;
+			}
+
+			if (Abs(t1) < bestT)
+			{
+				bestT = Abs(t1);
+				bestHitT = t1;
+				bestIndex = i;
+			}
+		}
+
+		if (bestIndex >= size)
+		{
+			return false;
+		}
+
+		hitIndex = bestIndex;
+		t = bestHitT;
+		fixHitPos = dir1 * bestHitT + segmentStart;
+
+		return true;
+	}
+
+	/** ****************************************************************************************************
+	 * @brief				移動する円が点に最初に接する割合を求める
+	 * @param[in] center	円の中心
+	 * @param[in] move		移動量
+	 * @param[in] radius	円の半径
+	 * @param[in] point		点
+	 * @param[out] t		接した場合の割合(既に重なっていた場合は 0)
+	 * @retval true			移動中に接した
+	 * @retval false		接していない、または離れていく
+	 **************************************************************************************************** */
+	inline bool CalcuSweptCircleToPoint(const Vec2& center, const Vec2& move, double radius, const Vec2& point, double& t) noexcept
+	{
+		const Vec2 m = center - point;
+		const double a = move.lengthSq();
+		const double b = m.dot(move);
+		const double c = m.lengthSq() - radius * radius;
+
+		// 動いていない、または離れていく
+		if (a == 0.0 || b >= 0.0)
+		{
+			return false;
+		}
+
+		// 既に重なっている
+		if (c <= 0.0)
+		{
+			t = 0.0;
+			return true;
+		}
+
+		// |m + move * t| = radius の小さい方の解
+		const double discriminant = b * b - a * c;
+		if (discriminant < 0.0)
+		{
+			return false;
+		}
+
+		t = (-b - std::sqrt(discriminant)) / a;
+
+		return t <= 1.0;
+	}
+
 	/** ****************************************************************************************************
 	 * @brief						線分と点の最短距離算出
 	 * @param[in] segmentStart		線分の始点